@@ -84,6 +84,7 @@ typedef struct {
             Target target;
             bool   is_release;
             bool   always_rebuild;
+            bool   is_profile;
         } build;
         struct OptRun {
             struct OptBuild build;
@@ -194,6 +195,9 @@ int main( int argc, char** argv ) {
                 } else if( strcmp( cl.buf[0], "-rebuild" ) == 0 ) {
                     opt.build.always_rebuild = true;
                     continue;
+                } else if( strcmp( cl.buf[0], "-profile" ) == 0 ) {
+                    opt.build.is_profile = true;
+                    continue;
                 }
             } break;
             case M_RUN: {
@@ -215,6 +219,9 @@ int main( int argc, char** argv ) {
                 } else if( strcmp( cl.buf[0], "-rebuild" ) == 0 ) {
                     opt.build.always_rebuild = true;
                     continue;
+                } else if( strcmp( cl.buf[0], "-profile" ) == 0 ) {
+                    opt.build.is_profile = true;
+                    continue;
                 } else if( strcmp( cl.buf[0], "--" ) == 0 ) {
                     opt.run.cl = CB_CL_NEXT( &cl );
                     break_loop = true;
@@ -474,7 +481,6 @@ int mode_build( Opt* opt ) {
     command_builder_reset(&cb);
     command_builder_append( &cb, cpp, "src/sources.cpp", "-Iinclude" );
     command_builder_append( &cb, raylib.buf, "-Iraylib/src" );
-    command_builder_append( &cb, "-Ijson.h" );
     command_builder_append( &cb, "-o", executable.buf );
     command_builder_append(
         &cb, "-Wall", "-Wextra", "-Werror=vla", "-Wno-missing-field-initializers" );
@@ -482,6 +488,9 @@ int mode_build( Opt* opt ) {
     if( !opt->build.is_release ) {
         command_builder_append( &cb, "-DIS_DEBUG" );
     }
+    if( opt->build.is_profile ) {
+        command_builder_append( &cb, "-DBOG_PROFILE" );
+    }
 
     switch( opt->build.target ) {
         case T_GNU_LINUX : {
@@ -775,6 +784,8 @@ int mode_help( Opt* opt ) {
             printf( "  -release     Build in release mode.\n" );
             printf( "                 Strips debug symbols and enables optimizations.\n" );
             printf( "  -rebuild     Always rebuild dependencies.\n" );
+            printf( "  -profile     Enable frame profiler.\n" );
+            printf( "                 Writes profile.json on exit, F9 writes it while running.\n" );
         } break;
         case M_RUN: {
             printf( "NOTE:\n" );
@@ -798,6 +809,8 @@ int mode_help( Opt* opt ) {
             printf( "  -release     Build in release mode.\n" );
             printf( "                 Strips debug symbols and enables optimizations.\n" );
             printf( "  -rebuild     Always rebuild dependencies.\n" );
+            printf( "  -profile     Enable frame profiler.\n" );
+            printf( "                 Writes profile.json on exit, F9 writes it while running.\n" );
             printf( "  --           Stop parsing arguments and pass remaining arguments to project.\n" );
         } break;
         case M_PACKAGE: {
@@ -8,22 +8,140 @@
 */
 #include "bog/prelude.h" // IWYU pragma: keep
 
+struct Allocator;
+struct Arena;
+struct FrameArena;
+struct Pool;
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN              (16)
+#define POOL_DEFAULT_CHUNK_COUNT (64)
+
 extern "C" void* _mem_reallocate( void* ptr, int size, int old_count, int new_count );
 extern "C" void  _mem_free( void* ptr, int size, int count );
 
+// NOTE(alicia): reallocate must zero memory past old_count,
+// same as the heap allocator. code relies on fresh list items being zeroed.
+typedef void* AllocatorReallocateFN(
+    Allocator* allocator, void* ptr, int size, int old_count, int new_count );
+typedef void AllocatorFreeFN(
+    Allocator* allocator, void* ptr, int size, int count );
+
+struct Allocator {
+    AllocatorReallocateFN* reallocate;
+    AllocatorFreeFN*       free;
+};
+
+// allocator == nullptr uses heap.
+void* _mem_reallocate_with(
+    Allocator* allocator, void* ptr, int size, int old_count, int new_count );
+void _mem_free_with( Allocator* allocator, void* ptr, int size, int count );
+
+// number of heap allocations made so far,
+// counts heap lists, arena blocks and pool chunks.
+u64 mem_heap_allocation_count();
+// heap allocations made during the last full frame.
+u64 mem_frame_heap_allocations();
+
+// scratch memory for the current frame,
+// allocations stay valid until the end of the next frame.
+Allocator* mem_frame();
+// called at the start of every frame, recycles frame memory.
+void mem_frame_begin();
+
 template<typename T>
-T* mem_alloc( int count ) {
-    return (T*)_mem_reallocate( nullptr, sizeof(T), 0, count );
+T* mem_alloc( int count, Allocator* allocator = nullptr ) {
+    return (T*)_mem_reallocate_with( allocator, nullptr, sizeof(T), 0, count );
 }
 
 template<typename T>
-T* mem_realloc( T* ptr, int old_count, int new_count ) {
-    return (T*)_mem_reallocate( ptr, sizeof(T), old_count, new_count );
+T* mem_realloc( T* ptr, int old_count, int new_count, Allocator* allocator = nullptr ) {
+    return (T*)_mem_reallocate_with( allocator, ptr, sizeof(T), old_count, new_count );
 }
 
 template<typename T>
-void mem_free( T* ptr, int count ) {
-    _mem_free( ptr, sizeof(T), count );
+void mem_free( T* ptr, int count, Allocator* allocator = nullptr ) {
+    _mem_free_with( allocator, ptr, sizeof(T), count );
 }
 
+void* _arena_reallocate( Allocator* allocator, void* ptr, int size, int old_count, int new_count );
+void  _arena_free( Allocator* allocator, void* ptr, int size, int count );
+
+void* _pool_reallocate( Allocator* allocator, void* ptr, int size, int old_count, int new_count );
+void  _pool_free( Allocator* allocator, void* ptr, int size, int count );
+
+struct ArenaBlock;
+
+// linear allocator.
+// freeing is a no-op unless it is the most recent allocation,
+// the most recent allocation also grows in place.
+// reset releases everything at once, if the arena had to chain blocks
+// they are merged into one block so that the next fill does not allocate.
+struct Arena {
+    Allocator allocator = { _arena_reallocate, _arena_free };
+
+    ArenaBlock* block;
+    /* minimum size of new blocks, 0 uses ARENA_DEFAULT_BLOCK_SIZE */
+    usize block_size;
+    /* bytes pushed since last reset */
+    usize used;
+
+    void* last;
+    usize last_size;
+
+    void* push( usize size );
+    void  reset();
+    void  free();
+
+    operator Allocator*() {
+        return &allocator;
+    }
+};
+
+// double buffered arena, allocations stay valid for the frame they
+// were made in and the frame after that.
+struct FrameArena {
+    Arena arenas[2];
+    int   current;
+
+    Arena* get() {
+        return arenas + current;
+    }
+    void next_frame() {
+        current = !current;
+        arenas[current].reset();
+    }
+    void free() {
+        arenas[0].free();
+        arenas[1].free();
+    }
+
+    operator Allocator*() {
+        return *get();
+    }
+};
+
+struct PoolChunk;
+
+// fixed size block allocator.
+// reallocating past item_size is an error.
+struct Pool {
+    Allocator allocator = { _pool_reallocate, _pool_free };
+
+    int item_size;
+    /* items per chunk, 0 uses POOL_DEFAULT_CHUNK_COUNT */
+    int chunk_count;
+
+    PoolChunk* chunks;
+    void*      free_list;
+
+    void* take();
+    void  give( void* item );
+    void  free();
+
+    operator Allocator*() {
+        return &allocator;
+    }
+};
+
 #endif /* header guard */
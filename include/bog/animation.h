@@ -9,6 +9,7 @@
 #include "bog/prelude.h"
 #include "bog/constants.h"
 #include "bog/collections.h"
+#include "bog/lookup.h"
 
 struct AnimationFrame;
 struct Animation;
@@ -212,8 +213,8 @@ float animation_calculate_length( int count, const AnimationFrame* frames ) {
     return result;
 }
 
-inline
-String string_from_animation( int animation ) {
+constexpr
+const char* _animation_name( int animation ) {
     switch( (AnimationCap)animation ) {
         case ANIM_BUTTON_GENERIC_SELECT          : return "button_generic_select";
         case ANIM_BUTTON_GENERIC_DESELECT        : return "button_generic_deselect";
@@ -267,15 +268,26 @@ String string_from_animation( int animation ) {
     }
     return "";
 }
+
+inline
+String string_from_animation( int animation ) {
+    return String( _animation_name( animation ) );
+}
+
+_readonly auto ANIMATION_LOOKUP =
+    string_lookup_build<ANIM_COUNT - 1>( _animation_name, ANIM_NONE + 1 );
+static_assert(
+    ANIMATION_LOOKUP.is_valid,
+    "every animation needs a unique name in _animation_name!" );
+
+// NOTE(alicia): compiled scenes store AnimationCap values,
+// they are rejected when this does not match.
+_readonly u32 ANIMATION_NAMES_HASH =
+    string_lookup_names_hash( _animation_name, ANIM_NONE + 1, ANIM_COUNT - 1 );
+
 inline
 bool animation_from_string( String string, int* out ) {
-    for( int i = ANIM_NONE + 1; i < ANIM_COUNT; ++i ) {
-        if( string_cmp( string, string_from_animation( i ) ) ) {
-            *out = i;
-            return true;
-        }
-    }
-    return false;
+    return ANIMATION_LOOKUP.find( string, out );
 }
 
 _readonly AnimationFrame __ANIM_NONE[] = {
@@ -0,0 +1,53 @@
+#if !defined(BOG_ASSETS_H)
+#define BOG_ASSETS_H
+/**
+ * @file   assets.h
+ * @brief  Asset cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 27, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+// NOTE(alicia): textures and music by path, shared between states.
+// acquire counts a reference and queues the asset on the loader if it
+// is not resident yet. released assets stay resident so that the next
+// state to ask for them gets them for free, least recently released
+// assets are unloaded once unused assets go over ASSET_CACHE_BUDGET.
+//
+// returned pointers are stable until the asset is released.
+
+#define ASSET_MAX_COUNT    (64)
+/* bytes of released assets kept resident */
+#if defined(PLATFORM_WEB)
+    #define ASSET_CACHE_BUDGET (8 * 1024 * 1024)
+#else
+    #define ASSET_CACHE_BUDGET (64 * 1024 * 1024)
+#endif
+
+struct AssetStats {
+    int count;
+    int unused_count;
+
+    usize bytes;
+    usize unused_bytes;
+
+    /* acquires that found the asset already cached */
+    u64 hits;
+    u64 misses;
+};
+
+const Texture* asset_texture_acquire( const char* path, int filter = TEXTURE_FILTER_POINT );
+void asset_texture_release( const Texture* texture );
+
+Music* asset_music_acquire( const char* path );
+void asset_music_release( const Music* music );
+// music has finished loading and can be played.
+// false while loading and if music failed to load.
+bool asset_music_is_ready( const Music* music );
+
+AssetStats asset_stats();
+
+// unload every asset, references are ignored.
+void asset_shutdown();
+
+#endif /* header guard */
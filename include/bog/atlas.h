@@ -0,0 +1,97 @@
+#if !defined(BOG_ATLAS_H)
+#define BOG_ATLAS_H
+/**
+ * @file   atlas.h
+ * @brief  Texture atlas.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 25, 2025
+*/
+#include "bog/prelude.h"
+#include "bog/constants.h"
+#include "bog/animation.h"
+
+#define ATLAS_TABLE_PATH "resources/textures/atlas.bin"
+#define ATLAS_PAGE_PATH  "resources/textures/atlas-%i.png"
+#define ATLAS_PAGE_SIZE  (2048)
+/* transparent gap between packed textures */
+#define ATLAS_PADDING    (2)
+
+// where a TEX_* texture ended up.
+// width and height are 0 when texture has a page to itself.
+struct AtlasEntry {
+    int page;
+    int x, y;
+    int width, height;
+};
+
+// a texture and a src rect ready for DrawTexturePro.
+struct Sprite {
+    Texture   texture;
+    Rectangle src;
+};
+
+// all TEX_* textures.
+// when packed, textures share a handful of pages and src rects are
+// moved into page space so that drawing does not switch textures.
+// without a packed atlas every texture is its own page at 0, 0.
+//
+// on demand textures (TextureLoadParams::is_on_demand) are never packed
+// and are only resident between atlas_require and atlas_release.
+struct TextureAtlas {
+    bool is_packed;
+
+    int            page_count;
+    const Texture* pages[TEX_COUNT];
+    AtlasEntry     entries[TEX_COUNT];
+
+    Texture texture( int texture ) const {
+        const Texture* page = pages[entries[texture].page];
+        return page ? *page : Texture{};
+    }
+
+    // src rect in texture space -> src rect in page space.
+    Rectangle src( int texture, Rectangle src ) const {
+        src.x += entries[texture].x;
+        src.y += entries[texture].y;
+        return src;
+    }
+
+    Sprite sprite( int texture, Rectangle src ) const {
+        return { this->texture( texture ), this->src( texture, src ) };
+    }
+    Sprite sprite( const AnimationFrame& frame ) const {
+        return sprite( frame.texture, frame.src );
+    }
+
+    // full texture, for backgrounds.
+    Sprite sprite( int texture ) const {
+        const auto& entry = entries[texture];
+        if( !entry.width ) {
+            Texture page = this->texture( texture );
+            return { page, { 0, 0, (float)page.width, (float)page.height } };
+        }
+
+        return sprite( texture, { 0, 0, (float)entry.width, (float)entry.height } );
+    }
+
+    bool is_resident( int texture ) const {
+        return pages[entries[texture].page] != nullptr;
+    }
+};
+
+// offline: pack TEXTURE_LOAD_PARAMS into ATLAS_PAGE_PATH pages
+// and write the placement table to ATLAS_TABLE_PATH.
+// does not need a window.
+bool atlas_pack();
+
+// acquire packed atlas pages from asset cache, falls back to textures one by one
+// if the atlas is missing or older than any of the textures.
+// pages have id 0 until the loader uploads them.
+void atlas_load( TextureAtlas* out );
+void atlas_unload( TextureAtlas* atlas );
+
+// acquire/release an on demand texture, does nothing if it already is/isn't.
+void atlas_require( TextureAtlas* atlas, int texture );
+void atlas_release( TextureAtlas* atlas, int texture );
+
+#endif /* header guard */
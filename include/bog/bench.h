@@ -0,0 +1,15 @@
+#if !defined(BOG_BENCH_H)
+#define BOG_BENCH_H
+/**
+ * @file   bench.h
+ * @brief  Benchmarks.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 20, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+// run benchmarks by name, runs all benchmarks if count is zero.
+// returns process exit code.
+int bench_run( int count, char** names );
+
+#endif /* header guard */
@@ -21,6 +21,7 @@ struct Slice;
 typedef Slice<char> String;
 
 struct StringOffset;
+struct InternTable;
 
 enum class StringConvert {
     NONE,
@@ -35,10 +36,32 @@ Slice<T> truncate( const Slice<T>& slice, int max );
 
 String advance( String string, String other );
 
+// NOTE(alicia): find_set and find_string scan with the widest vector instructions
+// that build and cpu support, AVX2 is picked at runtime on x86.
+// first 32 bytes are always scanned with scalar loop, find_char is always memchr.
+// every level returns the same result as SCALAR, which is the reference.
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2,
+
+    COUNT
+};
+String string_from_simd_level( SimdLevel level );
+// level used by find functions.
+SimdLevel simd_level();
+bool simd_level_is_supported( SimdLevel level );
+
 bool find_char( String string, char c, int* opt_out_index = nullptr );
 bool find_set( String string, String set, int* opt_out_index = nullptr );
 bool find_string( String string, String substring, int* opt_out_index = nullptr );
 
+// find functions at given level, level must be supported.
+bool find_char_simd( SimdLevel level, String string, char c, int* opt_out_index = nullptr );
+bool find_set_simd( SimdLevel level, String string, String set, int* opt_out_index = nullptr );
+bool find_string_simd(
+    SimdLevel level, String string, String substring, int* opt_out_index = nullptr );
+
 Color parse_color( String string );
 
 bool string_cmp( String a, String b );
@@ -47,25 +70,34 @@ StringOffset string_offset_push(
     List<char>* list, String string,
     bool no_null = false, StringConvert convert = StringConvert::NONE );
 
+u32 string_hash( String string );
+
 // NOTE(alicia): implementation -----------------------------------------------
 
 template<typename T>
 struct List {
     int cap, len;
     T*  buf;
+    /* nullptr uses heap */
+    Allocator* allocator;
 
-    void reserve( int amount = MINIMUM_ALLOC_COUNT ) {
+    void reserve( int amount = 1 ) {
         if( (cap - len) >= amount ) {
             return;
         }
 
-        int alloc_count = amount - (cap - len);
-        if( alloc_count < MINIMUM_ALLOC_COUNT ) {
-            alloc_count = MINIMUM_ALLOC_COUNT;
+        // NOTE(alicia): grow geometrically so that pushing n items
+        // only reallocates log(n) times.
+        int new_cap = cap * 2;
+        if( new_cap < MINIMUM_ALLOC_COUNT ) {
+            new_cap = MINIMUM_ALLOC_COUNT;
+        }
+        if( new_cap < (len + amount) ) {
+            new_cap = len + amount;
         }
 
-        buf = mem_realloc( buf, cap, cap + alloc_count );
-        cap += alloc_count;
+        buf = mem_realloc( buf, cap, new_cap, allocator );
+        cap = new_cap;
     }
 
     void reset() {
@@ -74,7 +106,7 @@ struct List {
 
     void free() {
         if( buf ) {
-            mem_free( buf, cap );
+            mem_free( buf, cap, allocator );
         }
         buf = nullptr;
         len = cap = 0;
@@ -244,6 +276,36 @@ struct StringOffset {
     }
 };
 
+/* maps strings to stable ids, ids are assigned in order starting at 0 */
+struct InternTable {
+    List<StringOffset> strings;
+    List<char>         string;
+    /* open addressing, id + 1 or 0 if empty. len is always power of two */
+    List<int>          slots;
+
+    // -1 if string has not been interned
+    int find( String key ) const;
+    int intern( String key );
+
+    int count() const {
+        return strings.len;
+    }
+    String get( int id ) const {
+        return strings[id].to_string( string );
+    }
+
+    void reset() {
+        strings.reset();
+        string.reset();
+        slots.reset();
+    }
+    void free() {
+        strings.free();
+        string.free();
+        slots.free();
+    }
+};
+
 template<typename T>
 Slice<T> advance( const Slice<T>& slice, int amount ) {
     Slice<T> result = slice;
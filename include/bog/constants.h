@@ -65,9 +65,15 @@ enum {
     TEX_COUNT
 };
 
+_readonly int BACKGROUND_COUNT = (TEX_BG6 - TEX_BG1) + 1;
+/* nodes ahead of current node scanned for assets to load */
+_readonly int PREFETCH_LOOKAHEAD_NODES = 24;
+
 struct TextureLoadParams {
     const char* path;
     int         filter = TEXTURE_FILTER_POINT;
+    /* not packed into atlas, only resident while a scene needs it */
+    bool        is_on_demand = false;
 };
 
 static TextureLoadParams TEXTURE_LOAD_PARAMS[] = {
@@ -79,12 +85,12 @@ static TextureLoadParams TEXTURE_LOAD_PARAMS[] = {
     { "resources/textures/stefan_sprite.png" },
     { "resources/textures/zuma_sprite.png" },
 
-    { "resources/textures/background1.png" },
-    { "resources/textures/background2.png" },
-    { "resources/textures/background3.png" },
-    { "resources/textures/background4.png" },
-    { "resources/textures/background5.png" },
-    { "resources/textures/background6.png" },
+    { "resources/textures/background1.png", TEXTURE_FILTER_POINT, true },
+    { "resources/textures/background2.png", TEXTURE_FILTER_POINT, true },
+    { "resources/textures/background3.png", TEXTURE_FILTER_POINT, true },
+    { "resources/textures/background4.png", TEXTURE_FILTER_POINT, true },
+    { "resources/textures/background5.png", TEXTURE_FILTER_POINT, true },
+    { "resources/textures/background6.png", TEXTURE_FILTER_POINT, true },
 };
 
 #endif /* header guard */
@@ -0,0 +1,46 @@
+#if !defined(BOG_FONTS_H)
+#define BOG_FONTS_H
+/**
+ * @file   fonts.h
+ * @brief  Font cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 30, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+#include "bog/collections.h"
+
+// NOTE(alicia): one font file at any number of sizes. every size starts
+// with ASCII, other glyphs are rasterized the first time text needs them
+// and packed into one atlas texture that all sizes share, so scripts with
+// thousands of glyphs cost nothing until their text shows up.
+//
+// glyph arrays are allocated once per size and the atlas never moves,
+// so fonts returned by the cache stay valid until font_cache_shutdown,
+// older copies just do not see glyphs added after them.
+// fonts from the cache must not be passed to UnloadFont.
+
+#define FONT_CACHE_MAX_SIZES  (4)
+/* glyphs per size */
+#define FONT_CACHE_MAX_GLYPHS (4096)
+#if defined(PLATFORM_WEB)
+    #define FONT_ATLAS_SIZE (1024)
+#else
+    #define FONT_ATLAS_SIZE (2048)
+#endif
+/* transparent gap around glyphs in atlas, same as LoadFontEx */
+#define FONT_GLYPH_PADDING (4)
+
+// read font file, sizes are created by font_cache_get.
+bool font_cache_load( const char* path );
+
+// font at size, created with ASCII glyphs the first time size is asked for.
+// default font if no font file is loaded.
+Font font_cache_get( int size );
+
+// rasterize codepoints of text that font does not have yet,
+// returns font with them. fonts not from cache are returned as is.
+Font font_cache_require( Font font, String text );
+
+void font_cache_shutdown();
+
+#endif /* header guard */
@@ -0,0 +1,25 @@
+#if !defined(BOG_HEADLESS_H)
+#define BOG_HEADLESS_H
+/**
+ * @file   headless.h
+ * @brief  Run game state without a window.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 22, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+// play through story with scripted input and a fixed frame time.
+// no window, textures or audio are created.
+//
+// options:
+//   -runs <n>        number of playthroughs, default 1000.
+//   -seed <n>        seed for picking fork options.
+//   -dt <seconds>    frame time, default 1/60.
+//   -max-frames <n>  frames before a playthrough counts as stuck.
+//   -typewriter      wait for text to be revealed instead of skipping it.
+//
+// returns process exit code, non-zero if a playthrough got stuck
+// or jumped to a node that does not exist.
+int headless_run( int count, char** args );
+
+#endif /* header guard */
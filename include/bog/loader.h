@@ -0,0 +1,54 @@
+#if !defined(BOG_LOADER_H)
+#define BOG_LOADER_H
+/**
+ * @file   loader.h
+ * @brief  Asset loading in the background.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 26, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+// NOTE(alicia): files are read and images decoded on worker threads,
+// only gpu upload and audio stream creation happen on the main thread,
+// in loader_update.
+// on web there are no worker threads so one job is run per loader_update.
+//
+// outputs stay zeroed until they are uploaded, raylib draws nothing
+// for texture id 0 so states can keep drawing while assets stream in.
+// outputs must stay at the same address until the job is done.
+
+#define LOADER_MAX_JOBS     (64)
+#define LOADER_MAX_PATH     (256)
+#define LOADER_THREAD_COUNT (2)
+
+struct LoaderProgress {
+    int done;
+    int total;
+
+    bool is_complete() const {
+        return done >= total;
+    }
+    float fraction() const {
+        return total ? ((float)done / (float)total) : 1.0f;
+    }
+};
+
+void loader_push_texture( const char* path, int filter, Texture* out );
+// music streams from memory so file data has to outlive it,
+// free out_data with UnloadFileData after unloading music.
+void loader_push_music( const char* path, Music* out, unsigned char** out_data, int* out_size );
+
+// is out still waiting on a queued job.
+bool loader_is_pending( const void* out );
+
+// main thread, called once per frame.
+void loader_update();
+// main thread, blocks until every queued job is done.
+void loader_wait();
+// jobs finished since loader was last idle.
+LoaderProgress loader_progress();
+
+// stops worker threads, queued jobs are finished first.
+void loader_shutdown();
+
+#endif /* header guard */
@@ -0,0 +1,141 @@
+#if !defined(BOG_LOOKUP_H)
+#define BOG_LOOKUP_H
+/**
+ * @file   lookup.h
+ * @brief  Compile time string -> enum lookup tables.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 24, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+#include "bog/collections.h"
+
+template<int Count>
+struct StringLookup;
+
+// NOTE(alicia): builds a perfect hash of enum names at compile time.
+// name_of must be constexpr and return a unique, non-empty name
+// for every value in [first, first + Count).
+//
+// _readonly auto LOOKUP = string_lookup_build<COUNT>( _name_of, 0 );
+// static_assert( LOOKUP.is_valid, "..." );
+template<int Count>
+constexpr StringLookup<Count> string_lookup_build( const char* (*name_of)( int ), int first );
+
+constexpr
+u32 string_lookup_hash( u32 seed, const char* string, int len ) {
+    u32 hash = 2166136261u + (seed * 0x9E3779B9u);
+    for( int i = 0; i < len; ++i ) {
+        hash = (hash ^ (u8)string[i]) * 16777619u;
+    }
+    // NOTE(alicia): fnv-1a low bits are weak, mix high bits down
+    // since table index only uses low bits.
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+// hash of names in [first, first + count) in order, changes when
+// a name is added, removed, renamed or moved to another value.
+constexpr
+u32 string_lookup_names_hash( const char* (*name_of)( int ), int first, int count ) {
+    u32 hash = (u32)count;
+    for( int i = 0; i < count; ++i ) {
+        const char* name = name_of( first + i );
+
+        int len = 0;
+        while( name[len] ) {
+            len++;
+        }
+        hash = string_lookup_hash( hash, name, len );
+    }
+    return hash;
+}
+
+constexpr
+int _string_lookup_table_size( int count ) {
+    // NOTE(alicia): mostly empty table so that a collision free seed
+    // turns up after a handful of tries.
+    int size = 8;
+    while( size < (count * 8) ) {
+        size *= 2;
+    }
+    return size;
+}
+
+template<int Count>
+struct StringLookup {
+    _readonly int TABLE_SIZE = _string_lookup_table_size( Count );
+    _readonly int MAX_SEED   = 256;
+
+    static_assert( Count > 0 && Count < 255, "string lookup supports 1-254 names!" );
+
+    u32  seed;
+    bool is_valid;
+
+    /* hash slot -> index + 1, 0 if slot is empty */
+    u8 slots[TABLE_SIZE];
+
+    const char* names[Count];
+    int         lens[Count];
+    int         values[Count];
+
+    bool find( String string, int* out_value ) const {
+        u32 hash = string_lookup_hash( seed, string.buf, string.len );
+
+        int index = slots[hash & (TABLE_SIZE - 1)];
+        if( !index-- ) {
+            return false;
+        }
+        if( lens[index] != string.len || memcmp( names[index], string.buf, string.len ) != 0 ) {
+            return false;
+        }
+
+        *out_value = values[index];
+        return true;
+    }
+};
+
+template<int Count>
+constexpr StringLookup<Count> string_lookup_build( const char* (*name_of)( int ), int first ) {
+    StringLookup<Count> result = {};
+
+    for( int i = 0; i < Count; ++i ) {
+        result.names[i]  = name_of( first + i );
+        result.values[i] = first + i;
+        while( result.names[i][result.lens[i]] ) {
+            result.lens[i]++;
+        }
+        if( !result.lens[i] ) {
+            return result;
+        }
+    }
+
+    // NOTE(alicia): duplicate names always collide so no seed is found for them.
+    for( u32 seed = 1; seed <= StringLookup<Count>::MAX_SEED; ++seed ) {
+        for( int i = 0; i < StringLookup<Count>::TABLE_SIZE; ++i ) {
+            result.slots[i] = 0;
+        }
+
+        bool is_collision_free = true;
+        for( int i = 0; i < Count; ++i ) {
+            u32 hash = string_lookup_hash( seed, result.names[i], result.lens[i] );
+            u8& slot = result.slots[hash & (StringLookup<Count>::TABLE_SIZE - 1)];
+            if( slot ) {
+                is_collision_free = false;
+                break;
+            }
+            slot = (u8)(i + 1);
+        }
+
+        if( is_collision_free ) {
+            result.seed     = seed;
+            result.is_valid = true;
+            return result;
+        }
+    }
+
+    return result;
+}
+
+#endif /* header guard */
@@ -0,0 +1,56 @@
+#if !defined(BOG_PROFILE_H)
+#define BOG_PROFILE_H
+/**
+ * @file   profile.h
+ * @brief  Frame profiler.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 23, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+// NOTE(alicia): profiling is compiled out unless BOG_PROFILE is defined,
+// build with ./cbuild build -profile to enable it.
+//
+// zone names must be string literals or otherwise outlive the profiler,
+// only the pointer is stored.
+
+#if defined(BOG_PROFILE)
+
+#define PROFILE_SAMPLE_COUNT (1 << 16)
+#define PROFILE_MAX_DEPTH    (32)
+
+#define _PROFILE_CONCAT2( a, b ) a##b
+#define _PROFILE_CONCAT( a, b ) _PROFILE_CONCAT2( a, b )
+
+// time rest of current scope.
+#define PROFILE_ZONE( name ) \
+    ProfileZone _PROFILE_CONCAT( _profile_zone_, __LINE__ )( name )
+// time until matching PROFILE_END, zones must nest.
+#define PROFILE_BEGIN( name ) profile_begin( name )
+#define PROFILE_END()         profile_end()
+
+void profile_begin( const char* name );
+void profile_end();
+
+// write most recent samples as chrome trace json,
+// open with chrome://tracing or ui.perfetto.dev.
+bool profile_export( const char* path );
+
+struct ProfileZone {
+    ProfileZone( const char* name ) {
+        profile_begin( name );
+    }
+    ~ProfileZone() {
+        profile_end();
+    }
+};
+
+#else
+
+#define PROFILE_ZONE( name )
+#define PROFILE_BEGIN( name )
+#define PROFILE_END()
+
+#endif
+
+#endif /* header guard */
@@ -0,0 +1,71 @@
+#if !defined(BOG_REPLAY_H)
+#define BOG_REPLAY_H
+/**
+ * @file   replay.h
+ * @brief  Frame input, recording and playback.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 31, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+struct State;
+
+// NOTE(alicia): states read mouse and frame time through frame_input
+// instead of raylib, input is sampled once at start of frame.
+// a recording keeps every frame's input, playback feeds it back with
+// recorded dt and no frame limit, so a session plays out the same way
+// on any build and frame times measure only what the build does.
+// each frame also keeps a checksum of game state so that playback can
+// tell where a build starts to play out differently.
+
+struct FrameInput {
+    float   dt;
+    Vector2 mouse;
+    /* bit for each mouse button held, 1 << MOUSE_BUTTON_* */
+    u8 down;
+    /* bit for each mouse button pressed this frame */
+    u8 pressed;
+};
+
+enum class ReplayMode {
+    NONE,
+    RECORD,
+    PLAYBACK,
+};
+
+// record frames until replay_finish writes them to path.
+bool replay_record( const char* path );
+// play back frames from path.
+bool replay_playback( const char* path );
+
+ReplayMode replay_mode();
+
+// sample, record or play back input, called at start of every frame.
+// returns false when playback is out of frames.
+bool replay_frame_begin( const State* state );
+
+// write recording or print playback frame times.
+// returns process exit code, non-zero if recording could not be written
+// or playback played out differently from recording.
+int replay_finish();
+
+const FrameInput& frame_input();
+
+inline
+Vector2 input_mouse_position() {
+    return frame_input().mouse;
+}
+inline
+bool input_mouse_down( int button ) {
+    return frame_input().down & (1 << button);
+}
+inline
+bool input_mouse_pressed( int button ) {
+    return frame_input().pressed & (1 << button);
+}
+inline
+float input_frame_time() {
+    return frame_input().dt;
+}
+
+#endif /* header guard */
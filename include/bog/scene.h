@@ -8,45 +8,181 @@
 */
 #include "bog/prelude.h" // IWYU pragma: keep
 #include "bog/collections.h"
+#include "bog/lookup.h"
 
 struct Node;
 struct Scene;
 
+struct StoryNode;
+struct ControlNode;
+struct WriteNode;
+struct ForkNode;
+struct FadeNode;
+
+enum class NodeType : u8;
+
+#define SCENE_COMPILED_EXT ".scene"
+
+// loads .json or compiled .scene file.
+// a .json path loads its compiled sibling instead if it is up to date.
 void scene_load( const char* path, Scene* out_scene );
 void scene_print( Scene* scene );
 
+// read id of scene at path without loading the rest of it.
+bool scene_read_id( const char* path, int* out_id );
+
+// parse json scene from memory, path is only used for error messages.
+void scene_parse( const char* path, String source, Scene* out_scene );
+
+// parse json scene at src_path and write it to dst_path in compiled format.
+bool scene_compile( const char* src_path, const char* dst_path );
+// release compiled scene file that scene data points into.
+void scene_unmap( Scene* scene );
+
+// rebuilds node id -> node index table, called by scene_parse.
+void scene_build_lookup( Scene* scene );
+// resolves jump targets to node indices, called by scene_parse after lookup is built.
+// panics if a jump goes to a node that is not in scene,
+// path is only used for error messages.
+void scene_link( const char* path, Scene* scene );
+
+// indices of nodes reachable from node_index, nearest first, node_index included.
+// follows next node, jumps, both sides of conditionals and every fork option.
+// jumps to other scenes are not followed.
+// stops after max_count nodes, out_indices must fit max_count.
+int scene_walk_ahead( Scene* scene, int node_index, int max_count, int* out_indices );
+
 bool scene_jump_calculate( Scene* scene, int* out_scene, int* out_node );
 
+// index of node after current node.
 // -1 means move on to the next scene
 int scene_jump_calculate_next( Scene* scene );
 
+// does a jump to scene_id leave scene, negative scene_id stays on scene.
+bool scene_is_other( const Scene* scene, int scene_id );
+
+// bytes taken up by nodes, their payloads, fork options and id lookup.
+usize scene_node_bytes( const Scene* scene );
+
+// NOTE(alicia): nodes are stored as arrays with one item per node
+// (type, id and payload index) and a pool of payloads for each node type,
+// so a node only takes up as much space as its type needs.
+// Node puts one node back together, it points into these lists.
 struct Scene {
     int id;
     StringOffset title;
 
-    List<Node> nodes;
+    /* one item per node, in scene order */
+    List<NodeType> types;
+    List<int>      ids;
+    /* index into payload pool of node type */
+    List<int>      payloads;
+
+    /* payload pools */
+    List<StoryNode>   stories;
+    List<ControlNode> controls;
+    List<WriteNode>   writes;
+    List<ForkNode>    forks;
+    List<FadeNode>    fades;
+
     List<char> string;
     List<char> storage;
 
-    int current_node;
+    /* node id -> index into nodes, open addressing keyed by id,
+     * power of two length, at least twice node count, -1 if slot is empty */
+    List<int> lookup;
+
+    /* key id -> key name, key ids are local to this scene */
+    List<StringOffset> keys;
 
-    Node* get_current();
+    /* non-null when lists above point into a compiled scene file */
+    void* mapping;
+    usize mapping_size;
+
+    /* backs lists above when scene is parsed from json, see reset */
+    Arena arena;
+
+    /* index of node, -1 at end of scene */
+    int current;
+
+    int node_count() const {
+        return types.len;
+    }
+
+    int index_of( int node_id ) const;
+    /* index must be in range */
+    Node node( int index );
+    /* empty node if there is no node with node_id */
+    Node get( int node_id );
+    /* empty node at end of scene */
+    Node get_current();
+    /* id of current node, -1 at end of scene */
+    int current_id() const;
+
+    String get_key( int key ) const {
+        return keys[key].to_string( string );
+    }
 
     void reset() {
+        if( mapping ) {
+            scene_unmap( this );
+        }
+
         id    = -1;
         title = {};
-        nodes.reset();
-        string.reset();
-        storage.reset();
+
+        // NOTE(alicia): lists are emptied rather than reset
+        // because resetting arena takes their memory back.
+        arena.reset();
+        types    = {};
+        ids      = {};
+        payloads = {};
+        stories  = {};
+        controls = {};
+        writes   = {};
+        forks    = {};
+        fades    = {};
+        string   = {};
+        storage  = {};
+        lookup   = {};
+        keys     = {};
+
+        types.allocator    = arena;
+        ids.allocator      = arena;
+        payloads.allocator = arena;
+        stories.allocator  = arena;
+        controls.allocator = arena;
+        writes.allocator   = arena;
+        forks.allocator    = arena;
+        fades.allocator    = arena;
+        string.allocator   = arena;
+        storage.allocator  = arena;
+        lookup.allocator   = arena;
+        keys.allocator     = arena;
     }
     void free() {
-        nodes.free();
+        if( mapping ) {
+            scene_unmap( this );
+        }
+
+        types.free();
+        ids.free();
+        payloads.free();
+        stories.free();
+        controls.free();
+        writes.free();
+        forks.free();
+        fades.free();
         string.free();
         storage.free();
+        lookup.free();
+        keys.free();
+
+        arena.free();
     }
 };
 
-enum class NodeType {
+enum class NodeType : u8 {
     NONE,
     STORY,
     CONTROL,
@@ -59,7 +195,7 @@ enum class NodeType {
 String string_from_node_type( NodeType type );
 bool node_type_from_string( String string, NodeType* out );
 
-enum class AnimationSide {
+enum class AnimationSide : u8 {
     KEEP,
     LEFT,
     CENTER,
@@ -70,7 +206,7 @@ enum class AnimationSide {
 String string_from_animation_side( AnimationSide side );
 bool animation_side_from_string( String string, AnimationSide* out );
 
-enum class ControlType {
+enum class ControlType : u8 {
     JUMP,
     CONDITIONAL,
 
@@ -79,7 +215,7 @@ enum class ControlType {
 String string_from_control_type( ControlType type );
 bool control_type_from_string( String string, ControlType* out );
 
-enum class ForkActionType {
+enum class ForkActionType : u8 {
     NONE,
     JUMP,
     WRITE,
@@ -96,10 +232,13 @@ struct ForkOption {
     union {
         struct {
             int scene, node;
+            /* index of node, -1 if node is in another scene */
+            int index;
         } jump;
         struct {
-            StringOffset key;
-            int          value;
+            /* scene key id */
+            int key;
+            int value;
         } write;
     };
 };
@@ -107,65 +246,149 @@ struct ForkOption {
 struct ConditionalJump {
     bool does_something;
     int  scene, node;
+    /* index of node, next node if jump does nothing.
+     * -1 if node is in another scene or there is no next node */
+    int  index;
 };
 
-struct Node {
-    NodeType type;
-    int id;
+struct StoryNode {
+    StringOffset text;
+    StringOffset character;
+    struct {
+        float         speed;
+        /* AnimationCap, resolved from name when scene is loaded */
+        u16           id;
+        AnimationSide side;
+        bool          clear;
+    } animation;
+    struct {
+        /* scene key id */
+        int key;
+        int value;
+    } write;
+    bool has_write;
+};
+
+struct ControlNode {
+    ControlType type;
     union {
         struct {
-            StringOffset text;
-            StringOffset character;
-            bool         has_write;
-            struct {
-                StringOffset  name;
-                float         speed;
-                AnimationSide side;
-                bool          clear;
-            } animation;
-            struct {
-                StringOffset key;
-                int          value;
-            } write;
-        } story;
+            /* scene key id */
+            int             key;
+            ConditionalJump if_false, if_true;
+        } conditional;
         struct {
-            ControlType  type;
-            union {
-                struct {
-                    StringOffset key;
-                    ConditionalJump if_false, if_true;
-                } conditional;
-                struct {
-                    int scene, node;
-                } jump;
-            };
-        } control;
-        struct {
-            StringOffset key;
-            int          value;
-        } write;
-        struct {
-            /* offset into string field of Scene */
-            int byte_offset;
-            /* number of ForkOption */
-            int len;
-        } fork;
-        struct {
-            bool reverse;
-        } fade;
+            int scene, node;
+            /* index of node, -1 if node is in another scene */
+            int index;
+        } jump;
     };
 };
 
+struct WriteNode {
+    /* scene key id */
+    int key;
+    int value;
+};
+
+struct ForkNode {
+    /* offset into storage field of Scene */
+    int byte_offset;
+    /* number of ForkOption */
+    int len;
+};
+
+struct FadeNode {
+    bool reverse;
+};
+
+struct Node {
+    NodeType type;
+    int      id;
+    /* index of node in scene, -1 if node is empty */
+    int      index;
+
+    /* payload of node type, null if node is empty */
+    union {
+        StoryNode*   story;
+        ControlNode* control;
+        WriteNode*   write;
+        ForkNode*    fork;
+        FadeNode*    fade;
+    };
+
+    bool is_empty() const {
+        return index < 0;
+    }
+};
+
 // NOTE(alicia): implementation ---------------------------------------------------------
 
 inline
-Node* Scene::get_current() {
-    for( int i = 0; i < nodes.len; ++i ) {
-        if( nodes[i].id == current_node ) {
-            return nodes + i;
+u32 scene_node_id_hash( int node_id ) {
+    u32 hash = (u32)node_id * 2654435769u;
+    return hash ^ (hash >> 16);
+}
+inline
+int Scene::index_of( int node_id ) const {
+    if( !lookup.len ) {
+        return -1;
+    }
+
+    u32 mask = lookup.len - 1;
+    for( u32 i = scene_node_id_hash( node_id ) & mask;; i = (i + 1) & mask ) {
+        int index = lookup[i];
+        if( index < 0 || ids[index] == node_id ) {
+            return index;
         }
     }
-    return nullptr;
+}
+inline
+Node Scene::node( int index ) {
+    Node result  = {};
+    result.type  = types[index];
+    result.id    = ids[index];
+    result.index = index;
+
+    int payload = payloads[index];
+    switch( result.type ) {
+        case NodeType::STORY   : result.story   = stories  + payload; break;
+        case NodeType::CONTROL : result.control = controls + payload; break;
+        case NodeType::WRITE   : result.write   = writes   + payload; break;
+        case NodeType::FORK    : result.fork    = forks    + payload; break;
+        case NodeType::FADE    : result.fade    = fades    + payload; break;
+
+        case NodeType::NONE:
+        case NodeType::COUNT:
+            break;
+    }
+    return result;
+}
+inline
+Node Scene::get( int node_id ) {
+    int index = index_of( node_id );
+    if( index < 0 ) {
+        Node result  = {};
+        result.index = -1;
+        return result;
+    }
+    return node( index );
+}
+inline
+Node Scene::get_current() {
+    if( current < 0 || current >= types.len ) {
+        Node result  = {};
+        result.index = -1;
+        return result;
+    }
+    return node( current );
+}
+inline
+int Scene::current_id() const {
+    if( current < 0 || current >= ids.len ) {
+        return -1;
+    }
+    return ids[current];
 }
 
 inline
@@ -177,21 +400,21 @@ bool scene_jump_calculate( Scene* scene, int* out_scene, int* out_node ) {
 }
 inline
 int scene_jump_calculate_next( Scene* scene ) {
-    for( int i = 0; i < scene->nodes.len; ++i ) {
-        if( scene->nodes[i].id == scene->current_node ) {
-            if( (i + 1) < scene->nodes.len ) {
-                return scene->nodes[i + 1].id;
-            } else {
-                return -1;
-            }
-        }
+    int index = scene->current;
+    if( index < 0 || (index + 1) >= scene->node_count() ) {
+        return -1;
     }
-    return -1;
+    return index + 1;
 }
 
 inline
-String string_from_node_type( NodeType type ) {
-    switch( type ) {
+bool scene_is_other( const Scene* scene, int scene_id ) {
+    return scene_id >= 0 && scene_id != scene->id;
+}
+
+constexpr
+const char* _node_type_name( int value ) {
+    switch( (NodeType)value ) {
         case NodeType::NONE    : return "none";
         case NodeType::STORY   : return "story";
         case NodeType::CONTROL : return "control";
@@ -204,8 +427,12 @@ String string_from_node_type( NodeType type ) {
     return "";
 }
 inline
-String string_from_animation_side( AnimationSide side ) {
-    switch( side ) {
+String string_from_node_type( NodeType type ) {
+    return String( _node_type_name( (int)type ) );
+}
+constexpr
+const char* _animation_side_name( int value ) {
+    switch( (AnimationSide)value ) {
         case AnimationSide::KEEP   : return "keep";
         case AnimationSide::LEFT   : return "left";
         case AnimationSide::CENTER : return "center";
@@ -216,8 +443,12 @@ String string_from_animation_side( AnimationSide side ) {
     return "";
 }
 inline
-String string_from_control_type( ControlType type ) {
-    switch( type ) {
+String string_from_animation_side( AnimationSide side ) {
+    return String( _animation_side_name( (int)side ) );
+}
+constexpr
+const char* _control_type_name( int value ) {
+    switch( (ControlType)value ) {
         case ControlType::JUMP:        return "jump";
         case ControlType::CONDITIONAL: return "conditional";
 
@@ -226,8 +457,12 @@ String string_from_control_type( ControlType type ) {
     return "";
 }
 inline
-String string_from_fork_action_type( ForkActionType type ) {
-    switch( type ) {
+String string_from_control_type( ControlType type ) {
+    return String( _control_type_name( (int)type ) );
+}
+constexpr
+const char* _fork_action_type_name( int value ) {
+    switch( (ForkActionType)value ) {
         case ForkActionType::NONE  : return "none";
         case ForkActionType::JUMP  : return "jump";
         case ForkActionType::WRITE : return "write";
@@ -236,45 +471,61 @@ String string_from_fork_action_type( ForkActionType type ) {
     }
     return "";
 }
+inline
+String string_from_fork_action_type( ForkActionType type ) {
+    return String( _fork_action_type_name( (int)type ) );
+}
+_readonly auto NODE_TYPE_LOOKUP =
+    string_lookup_build<(int)NodeType::COUNT>( _node_type_name, 0 );
+static_assert( NODE_TYPE_LOOKUP.is_valid, "node_type names must be unique and not empty!" );
+
 inline
 bool node_type_from_string( String string, NodeType* out ) {
-    for( int i = 0; i < (int)NodeType::COUNT; ++i ) {
-        if( string_cmp( string, string_from_node_type( (NodeType)i ) ) ) {
-            *out = (NodeType)i;
-            return true;
-        }
+    int value = 0;
+    if( !NODE_TYPE_LOOKUP.find( string, &value ) ) {
+        return false;
     }
-    return false;
+    *out = (NodeType)value;
+    return true;
 }
+_readonly auto ANIMATION_SIDE_LOOKUP =
+    string_lookup_build<(int)AnimationSide::COUNT>( _animation_side_name, 0 );
+static_assert( ANIMATION_SIDE_LOOKUP.is_valid, "animation_side names must be unique and not empty!" );
+
 inline
 bool animation_side_from_string( String string, AnimationSide* out ) {
-    for( int i = 0; i < (int)AnimationSide::COUNT; ++i ) {
-        if( string_cmp( string, string_from_animation_side( (AnimationSide)i ) ) ) {
-            *out = (AnimationSide)i;
-            return true;
-        }
+    int value = 0;
+    if( !ANIMATION_SIDE_LOOKUP.find( string, &value ) ) {
+        return false;
     }
-    return false;
+    *out = (AnimationSide)value;
+    return true;
 }
+_readonly auto CONTROL_TYPE_LOOKUP =
+    string_lookup_build<(int)ControlType::COUNT>( _control_type_name, 0 );
+static_assert( CONTROL_TYPE_LOOKUP.is_valid, "control_type names must be unique and not empty!" );
+
 inline
 bool control_type_from_string( String string, ControlType* out ) {
-    for( int i = 0; i < (int)ControlType::COUNT; ++i ) {
-        if( string_cmp( string, string_from_control_type( (ControlType)i ) ) ) {
-            *out = (ControlType)i;
-            return true;
-        }
+    int value = 0;
+    if( !CONTROL_TYPE_LOOKUP.find( string, &value ) ) {
+        return false;
     }
-    return false;
+    *out = (ControlType)value;
+    return true;
 }
+_readonly auto FORK_ACTION_TYPE_LOOKUP =
+    string_lookup_build<(int)ForkActionType::COUNT>( _fork_action_type_name, 0 );
+static_assert( FORK_ACTION_TYPE_LOOKUP.is_valid, "fork_action_type names must be unique and not empty!" );
+
 inline
 bool fork_action_type_from_string( String string, ForkActionType* out ) {
-    for( int i = 0; i < (int)ForkActionType::COUNT; ++i ) {
-        if( string_cmp( string, string_from_fork_action_type( (ForkActionType)i ) ) ) {
-            *out = (ForkActionType)i;
-            return true;
-        }
+    int value = 0;
+    if( !FORK_ACTION_TYPE_LOOKUP.find( string, &value ) ) {
+        return false;
     }
-    return false;
+    *out = (ForkActionType)value;
+    return true;
 }
 
 #endif /* header guard */
@@ -0,0 +1,57 @@
+#if !defined(BOG_SCENES_H)
+#define BOG_SCENES_H
+/**
+ * @file   scenes.h
+ * @brief  Scene cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 28, 2025
+*/
+#include "bog/prelude.h" // IWYU pragma: keep
+
+struct Scene;
+
+// NOTE(alicia): every scene in SCENE_DIRECTORY by id.
+// only ids are read when scenes are listed, a scene is loaded
+// the first time it is acquired and stays loaded after it is released
+// so that jumping back and forth between scenes does not load them again.
+// least recently released scenes are unloaded once more than
+// SCENE_CACHE_COUNT are loaded.
+//
+// returned pointers are stable until the scene is released.
+
+#define SCENE_DIRECTORY   "resources/scenes"
+#define SCENE_MAX_COUNT   (256)
+#define SCENE_CACHE_COUNT (8)
+
+struct SceneStats {
+    int count;
+    int loaded_count;
+
+    /* acquires that found the scene already loaded */
+    u64 hits;
+    u64 misses;
+};
+
+// list scenes in SCENE_DIRECTORY, does nothing if they are already listed.
+void scenes_scan();
+
+// lowest scene id, -1 if there are no scenes.
+int scenes_first();
+// scene that follows scene_id in id order, -1 if scene_id is the last one.
+int scenes_after( int scene_id );
+
+// null if there is no scene with scene_id.
+Scene* scenes_acquire( int scene_id );
+void scenes_release( Scene* scene );
+
+// check that every jump into another scene goes to a node that exists,
+// jumps within a scene are checked when it is loaded.
+// loads every scene, returns number of jumps that go nowhere.
+int scenes_validate();
+
+SceneStats scenes_stats();
+
+// unload every scene and forget listed scenes, references are ignored.
+void scenes_shutdown();
+
+#endif /* header guard */
@@ -12,6 +12,9 @@
 #include "bog/variable.h"
 #include "bog/constants.h"
 #include "bog/animation.h"
+#include "bog/atlas.h"
+#include "bog/loader.h"
+#include "bog/assets.h"
 
 enum class StateType {
     INVALID,
@@ -31,7 +34,7 @@ struct IntroState {
 };
 
 struct MainMenuState {
-    Texture texture;
+    const Texture* texture;
     bool is_settings_open;
     bool is_credits_open;
 
@@ -45,8 +48,8 @@ struct MainMenuState {
         AnimationTimeline buttons[4];
     };
 
-    Texture first;
-    Texture second;
+    const Texture* first;
+    const Texture* second;
 };
 
 enum class GameStepType {
@@ -75,7 +78,7 @@ struct ButtonList {
 
     void push( String text );
     int update_and_draw(
-        Font font, Texture* textures, Vector2 screen, Vector2 mouse, bool left_pressed, float dt );
+        Font font, const TextureAtlas* atlas, Vector2 screen, Vector2 mouse, bool left_pressed, float dt );
 };
 
 struct Settings {
@@ -109,11 +112,30 @@ struct GameState {
     float fade_timer;
     bool  fade_is_reverse;
 
-    Texture   textures[TEX_COUNT];
-    Scene     scene;
-    StorageKV kv;
-
-    int scene_id = -1, node_id = -1;
+    TextureAtlas atlas;
+    /* acquired from scene cache */
+    Scene*       scene;
+    StorageKV    kv;
+
+    /* scene key id -> kv key id */
+    List<int> scene_keys;
+
+    /* kv key ids read every frame */
+    struct {
+        int bg;
+        int music;
+        int act;
+        int one_playthrough;
+        int start_game;
+        int game_finished;
+    } key;
+
+    /* scene and node index of last frame */
+    int scene_id = -1, node_index = -1;
+    /* jump taken this frame that goes to another scene, -1 stays on current scene */
+    int target_scene = -1, target_scene_node = -1;
+    /* index of node that resident assets were last picked for */
+    int prefetch_index = -1;
 
     String character_name;
     String text;
@@ -148,17 +170,36 @@ struct GameState {
         AnimationTimeline anim[4];
     };
 
-    int   current_music = -1;
-    Music music[MUS_COUNT];
+    int    current_music = -1;
+    /* null unless current or prefetched */
+    Music* music[MUS_COUNT];
 
     float last_music_volume = 0.001f;
 };
 
+// what the player did during one frame of game state.
+// gathered from mouse when windowed, supplied by a script when headless.
+struct GameInput {
+    float dt;
+    /* clicked on text box */
+    bool advance;
+    /* text is revealed faster while held */
+    bool fast_text;
+    /* show rest of text at once */
+    bool reveal_text;
+    /* selected fork option, -1 if none */
+    int choice;
+};
+
 struct Common {
     bool is_first_frame;
     bool game_finished_once;
     Font font;
     Settings settings;
+
+    /* no window, textures or audio. game reads input instead of mouse */
+    bool      is_headless;
+    GameInput input;
 };
 
 struct State {
@@ -194,5 +235,8 @@ void _menu_update( State* state );
 void _game_load( State* state );
 void _game_unload( State* state );
 void _game_update( State* state );
+void _game_update_headless( State* state );
+// bit for each TEX_* and MUS_* that current node or nodes a little ahead of it could need.
+void _game_prefetch_wanted( GameState* s, u32* out_textures, u32* out_music );
 
 #endif /* header guard */
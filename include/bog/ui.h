@@ -11,6 +11,7 @@
 #include "bog/constants.h"
 
 struct Settings;
+struct TextureAtlas;
 
 enum class UI_WordType {
     TEXT,
@@ -30,10 +31,46 @@ struct UI_Word {
     };
 };
 
+struct UI_Glyph {
+    /* quad on screen, empty for bytes after first byte of a codepoint */
+    Rectangle dst;
+    /* quad in font atlas, normalized */
+    Rectangle uv;
+    Color     tint;
+    char      c;
+    /* bottom right corner of text if it ends after this glyph */
+    Vector2   extent;
+};
+
+/* word wrapped text, ready to draw. one glyph for each byte of text that is not a command */
+struct UI_Layout {
+    const char* buf;
+    int         len;
+    u32         hash;
+    u32         font_texture;
+    int         font_size;
+    Rectangle   bounds;
+    Vector2     position;
+
+    u64 last_used;
+    /* new every time layout is built */
+    u64 id;
+
+    int            word_count;
+    Vector2        start;
+    List<UI_Glyph> glyphs;
+};
+
 struct DisplayTextState {
     float timer;
     int   len;
 
+    // NOTE(alicia): reveal cursor, layout that len indexes into.
+    // set by text_draw so that revealing text does not look up
+    // or rebuild the layout, reset state when string changes.
+    const UI_Layout* layout;
+    u64              layout_id;
+
     bool is_complete( String string ) const {
         return len >= string.len;
     }
@@ -43,7 +80,7 @@ Rectangle draw_settings( Settings* settings, Font font, bool* is_open );
 Rectangle draw_credits( Font font, bool* is_open );
 
 Rectangle text_box_draw(
-    Texture tex, float y_offset, float height, Rectangle* out_area = nullptr );
+    const TextureAtlas* atlas, float y_offset, float height, Rectangle* out_area = nullptr );
 
 float text_set_display_speed( float speed = 1.0f );
 float text_get_display_speed();
@@ -56,8 +93,15 @@ Vector2 text_measure_slice(
 
 int text_split_words( Font font, String text, float font_size, List<UI_Word>* out_words );
 
+// get cached layout of string, layout is rebuilt only when
+// string, font, bounds or position change.
+const UI_Layout* text_layout( Font font, String string, Vector2 position, Rectangle bounds );
+
 Rectangle text_measure( Font font, String string, Vector2 position );
 
+// advance typewriter effect, called by text_draw.
+void text_display_update( DisplayTextState* state, float dt );
+
 Rectangle text_draw(
     Font              font,
     String            string,
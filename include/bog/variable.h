@@ -9,66 +9,42 @@
 #include "bog/prelude.h"
 #include "bog/collections.h"
 
-struct KV {
-    StringOffset key;
-    int          value;
-};
-
 struct StorageKV {
-    List<KV>   pairs;
-    List<char> string;
-
-    int read( String key ) {
-        for( int i = 0; i < pairs.len; ++i ) {
-            auto* pair = pairs + i;
-            String this_key = pair->key.to_string( string );
-            if( string_cmp( this_key, key ) ) {
-                return pair->value;
-            }
+    InternTable keys;
+    /* key id -> value */
+    List<int>   values;
+
+    // get id of key, key is created with value 0 if it does not exist.
+    // ids stay the same until reset.
+    int id( String key ) {
+        int result = keys.intern( key );
+        while( values.len < keys.count() ) {
+            values.push( 0 );
         }
+        return result;
+    }
 
-        bool no_null = true;
-        KV pair;
-        pair.key   = string_offset_push( &string, key, no_null );
-        pair.value = 0;
-
-        pairs.push( pair );
+    int read( int id ) const {
+        return values[id];
+    }
+    int write( int id, int value ) {
+        return values[id] = value;
+    }
 
-        return 0;
+    int read( String key ) {
+        return read( id( key ) );
     }
     int write( String key, int value ) {
-        int found = -1;
-        for( int i = 0; i < pairs.len; ++i ) {
-            auto* pair = pairs + i;
-            String this_key = pair->key.to_string( string );
-
-            if( string_cmp( this_key, key ) ) {
-                found = i;
-                break;
-            }
-        }
-
-        bool no_null = true;
-        if( found >= 0 ) {
-            return pairs[found].value = value;
-        }
-
-        KV pair = {};
-        pair.key   = string_offset_push( &string, key, no_null );
-        pair.value = value;
-
-        pairs.push( pair );
-
-        return value;
+        return write( id( key ), value );
     }
 
     void reset() {
-        pairs.reset();
-        string.reset();
+        keys.reset();
+        values.reset();
     }
     void free() {
-        pairs.free();
-        string.free();
+        keys.free();
+        values.free();
     }
 };
 
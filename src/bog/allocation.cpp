@@ -8,7 +8,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define ALIGN_UP( x, alignment ) (((x) + ((alignment) - 1)) & ~((usize)(alignment) - 1))
+
+struct StateMemory {
+    u64 heap_allocations;
+    u64 frame_start_heap_allocations;
+    u64 frame_heap_allocations;
+
+    FrameArena frame;
+} __MEMORY = {};
+
 extern "C" void* _mem_reallocate( void* ptr, int size, int old_count, int new_count ) {
+    __MEMORY.heap_allocations++;
+
     if( ptr ) {
         void* new_ptr = realloc( ptr, size * new_count );
         if( !new_ptr ) {
@@ -31,4 +43,245 @@ extern "C" void _mem_free( void* ptr, int size, int count ) {
     free( ptr );
 }
 
+u64 mem_heap_allocation_count() {
+    return __MEMORY.heap_allocations;
+}
+u64 mem_frame_heap_allocations() {
+    return __MEMORY.frame_heap_allocations;
+}
+
+Allocator* mem_frame() {
+    return __MEMORY.frame;
+}
+void mem_frame_begin() {
+    __MEMORY.frame_heap_allocations =
+        __MEMORY.heap_allocations - __MEMORY.frame_start_heap_allocations;
+
+    __MEMORY.frame_start_heap_allocations = __MEMORY.heap_allocations;
+
+    __MEMORY.frame.next_frame();
+}
+
+void* _mem_reallocate_with(
+    Allocator* allocator, void* ptr, int size, int old_count, int new_count
+) {
+    if( allocator ) {
+        return allocator->reallocate( allocator, ptr, size, old_count, new_count );
+    }
+    return _mem_reallocate( ptr, size, old_count, new_count );
+}
+void _mem_free_with( Allocator* allocator, void* ptr, int size, int count ) {
+    if( allocator ) {
+        allocator->free( allocator, ptr, size, count );
+        return;
+    }
+    _mem_free( ptr, size, count );
+}
+
+// NOTE(alicia): arena ---------------------------------------------------------
+
+struct ArenaBlock {
+    ArenaBlock* prev;
+    usize       cap;
+    usize       len;
+};
+
+_readonly usize ARENA_BLOCK_HEADER_SIZE = ALIGN_UP( sizeof(ArenaBlock), ARENA_ALIGN );
+
+static u8* arena_block_data( ArenaBlock* block ) {
+    return (u8*)block + ARENA_BLOCK_HEADER_SIZE;
+}
+
+static ArenaBlock* arena_block_new( ArenaBlock* prev, usize cap ) {
+    __MEMORY.heap_allocations++;
+
+    auto* block = (ArenaBlock*)malloc( ARENA_BLOCK_HEADER_SIZE + cap );
+    Assert( block, "failed to allocate arena block of %zu bytes!", cap );
+
+    block->prev = prev;
+    block->cap  = cap;
+    block->len  = 0;
+    return block;
+}
+
+void* Arena::push( usize size ) {
+    size = ALIGN_UP( size, ARENA_ALIGN );
+
+    if( !block || (block->len + size) > block->cap ) {
+        usize cap = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+        if( block && (block->cap * 2) > cap ) {
+            cap = block->cap * 2;
+        }
+        if( size > cap ) {
+            cap = size;
+        }
+
+        block = arena_block_new( block, cap );
+    }
+
+    void* result = arena_block_data( block ) + block->len;
+    block->len += size;
+    used       += size;
+
+    last      = result;
+    last_size = size;
+
+    memset( result, 0, size );
+    return result;
+}
+void Arena::reset() {
+    if( block && block->prev ) {
+        usize total = 0;
+        while( block ) {
+            ArenaBlock* prev = block->prev;
+            total += block->cap;
+            ::free( block );
+            block = prev;
+        }
+
+        block = arena_block_new( nullptr, total );
+    }
+
+    if( block ) {
+        block->len = 0;
+    }
+
+    used      = 0;
+    last      = nullptr;
+    last_size = 0;
+}
+void Arena::free() {
+    while( block ) {
+        ArenaBlock* prev = block->prev;
+        ::free( block );
+        block = prev;
+    }
+
+    used      = 0;
+    last      = nullptr;
+    last_size = 0;
+}
+
+void* _arena_reallocate( Allocator* allocator, void* ptr, int size, int old_count, int new_count ) {
+    auto* arena = (Arena*)allocator;
+
+    usize old_size = (usize)size * old_count;
+    usize new_size = (usize)size * new_count;
+
+    if( ptr && ptr == arena->last ) {
+        ArenaBlock* block = arena->block;
+
+        usize offset   = (u8*)ptr - arena_block_data( block );
+        usize new_last = ALIGN_UP( new_size, ARENA_ALIGN );
+        if( (offset + new_last) <= block->cap ) {
+            block->len  = offset + new_last;
+            arena->used = arena->used - arena->last_size + new_last;
+
+            arena->last_size = new_last;
+
+            if( new_size > old_size ) {
+                memset( (u8*)ptr + old_size, 0, new_size - old_size );
+            }
+            return ptr;
+        }
+    }
+
+    void* result = arena->push( new_size );
+    if( ptr ) {
+        memcpy( result, ptr, old_size < new_size ? old_size : new_size );
+    }
+    return result;
+}
+void _arena_free( Allocator* allocator, void* ptr, int size, int count ) {
+    (void)size, (void)count;
+    auto* arena = (Arena*)allocator;
+
+    if( ptr && ptr == arena->last ) {
+        arena->block->len -= arena->last_size;
+        arena->used       -= arena->last_size;
+
+        arena->last      = nullptr;
+        arena->last_size = 0;
+    }
+}
+
+// NOTE(alicia): pool ----------------------------------------------------------
+
+struct PoolChunk {
+    PoolChunk* next;
+};
+
+_readonly usize POOL_CHUNK_HEADER_SIZE = ALIGN_UP( sizeof(PoolChunk), ARENA_ALIGN );
+
+static usize pool_stride( int item_size ) {
+    usize size = item_size > (int)sizeof(void*) ? item_size : sizeof(void*);
+    return ALIGN_UP( size, ARENA_ALIGN );
+}
+
+void* Pool::take() {
+    Assert( item_size > 0, "pool item size is not set!" );
+
+    if( !free_list ) {
+        int   count  = chunk_count ? chunk_count : POOL_DEFAULT_CHUNK_COUNT;
+        usize stride = pool_stride( item_size );
+
+        __MEMORY.heap_allocations++;
+
+        auto* chunk = (PoolChunk*)malloc( POOL_CHUNK_HEADER_SIZE + (stride * count) );
+        Assert( chunk, "failed to allocate pool chunk!" );
+
+        chunk->next = chunks;
+        chunks      = chunk;
+
+        u8* items = (u8*)chunk + POOL_CHUNK_HEADER_SIZE;
+        for( int i = count; i-- > 0; ) {
+            void* item = items + (stride * i);
+            *(void**)item = free_list;
+            free_list     = item;
+        }
+    }
+
+    void* result = free_list;
+    free_list    = *(void**)result;
+
+    memset( result, 0, item_size );
+    return result;
+}
+void Pool::give( void* item ) {
+    if( !item ) {
+        return;
+    }
+
+    *(void**)item = free_list;
+    free_list     = item;
+}
+void Pool::free() {
+    while( chunks ) {
+        PoolChunk* next = chunks->next;
+        ::free( chunks );
+        chunks = next;
+    }
+    free_list = nullptr;
+}
+
+void* _pool_reallocate( Allocator* allocator, void* ptr, int size, int old_count, int new_count ) {
+    auto* pool = (Pool*)allocator;
+
+    Assert(
+        size * new_count <= pool->item_size,
+        "pool allocation of %i bytes exceeds item size %i!", size * new_count, pool->item_size );
+
+    if( !ptr ) {
+        return pool->take();
+    }
+
+    if( new_count > old_count ) {
+        memset( (u8*)ptr + (size * old_count), 0, size * (new_count - old_count) );
+    }
+    return ptr;
+}
+void _pool_free( Allocator* allocator, void* ptr, int size, int count ) {
+    (void)size, (void)count;
+    ((Pool*)allocator)->give( ptr );
+}
 
@@ -0,0 +1,256 @@
+/**
+ * @file   assets.cpp
+ * @brief  Asset cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 27, 2025
+*/
+#include "bog/assets.h"
+#include "bog/loader.h"
+#include "bog/lookup.h"
+#include <string.h>
+
+enum class AssetType {
+    NONE,
+    TEXTURE,
+    MUSIC,
+};
+
+struct Asset {
+    AssetType type;
+    u32       hash;
+    char      path[LOADER_MAX_PATH];
+
+    int refs;
+    /* release tick, lowest is evicted first */
+    u64 last_used;
+
+    Texture texture;
+    int     filter;
+
+    Music          music;
+    unsigned char* music_data;
+    int            music_data_size;
+};
+
+struct StateAssets {
+    Asset assets[ASSET_MAX_COUNT];
+
+    u64 tick;
+    u64 hits;
+    u64 misses;
+};
+static StateAssets __ASSETS;
+
+static const void* asset_output( const Asset* asset ) {
+    if( asset->type == AssetType::MUSIC ) {
+        return &asset->music;
+    }
+    return &asset->texture;
+}
+
+static usize asset_size( const Asset* asset ) {
+    switch( asset->type ) {
+        case AssetType::TEXTURE: {
+            const auto& t = asset->texture;
+            return t.id ? GetPixelDataSize( t.width, t.height, t.format ) : 0;
+        } break;
+        case AssetType::MUSIC: {
+            return asset->music_data_size;
+        } break;
+        case AssetType::NONE:
+            break;
+    }
+    return 0;
+}
+
+static void asset_unload( Asset* asset ) {
+    // NOTE(alicia): loader still has a pointer to asset.
+    if( loader_is_pending( asset_output( asset ) ) ) {
+        loader_wait();
+    }
+
+    switch( asset->type ) {
+        case AssetType::TEXTURE: {
+            if( asset->texture.id ) {
+                UnloadTexture( asset->texture );
+            }
+        } break;
+        case AssetType::MUSIC: {
+            if( IsMusicValid( asset->music ) ) {
+                UnloadMusicStream( asset->music );
+            }
+            if( asset->music_data ) {
+                UnloadFileData( asset->music_data );
+            }
+        } break;
+        case AssetType::NONE:
+            break;
+    }
+
+    *asset = {};
+}
+
+// NOTE(alicia): unused asset that was released the longest time ago.
+// assets still being loaded are skipped, their size is not known yet.
+static Asset* asset_least_recently_used() {
+    Asset* result = nullptr;
+    for( auto& asset : __ASSETS.assets ) {
+        if( asset.type == AssetType::NONE || asset.refs ) {
+            continue;
+        }
+        if( loader_is_pending( asset_output( &asset ) ) ) {
+            continue;
+        }
+        if( !result || asset.last_used < result->last_used ) {
+            result = &asset;
+        }
+    }
+    return result;
+}
+
+static void asset_trim() {
+    for( ;; ) {
+        AssetStats stats = asset_stats();
+        if( stats.unused_bytes <= ASSET_CACHE_BUDGET ) {
+            break;
+        }
+
+        Asset* lru = asset_least_recently_used();
+        if( !lru ) {
+            break;
+        }
+        TraceLog( LOG_INFO, "%s: evicted from asset cache.", lru->path );
+        asset_unload( lru );
+    }
+}
+
+static Asset* asset_acquire( AssetType type, const char* path, bool* out_is_new ) {
+    u32 hash = string_lookup_hash( 0, path, (int)strlen( path ) );
+
+    Asset* empty = nullptr;
+    for( auto& asset : __ASSETS.assets ) {
+        if( asset.type == AssetType::NONE ) {
+            if( !empty ) {
+                empty = &asset;
+            }
+            continue;
+        }
+        if( asset.type == type && asset.hash == hash && strcmp( asset.path, path ) == 0 ) {
+            __ASSETS.hits++;
+
+            asset.refs++;
+            *out_is_new = false;
+            return &asset;
+        }
+    }
+
+    if( !empty ) {
+        empty = asset_least_recently_used();
+        Assert( empty, "asset cache is full!" );
+        asset_unload( empty );
+    }
+
+    Assert( strlen( path ) < LOADER_MAX_PATH, "%s: asset path is too long!", path );
+
+    __ASSETS.misses++;
+
+    empty->type = type;
+    empty->hash = hash;
+    empty->refs = 1;
+    strcpy( empty->path, path );
+
+    *out_is_new = true;
+    return empty;
+}
+
+static void asset_release( Asset* asset ) {
+    Assert( asset->refs > 0, "%s: asset released more times than it was acquired!", asset->path );
+
+    asset->refs--;
+    asset->last_used = ++__ASSETS.tick;
+
+    if( !asset->refs ) {
+        asset_trim();
+    }
+}
+
+static Asset* asset_from_output( const void* output ) {
+    for( auto& asset : __ASSETS.assets ) {
+        if( asset.type != AssetType::NONE && asset_output( &asset ) == output ) {
+            return &asset;
+        }
+    }
+    return nullptr;
+}
+
+const Texture* asset_texture_acquire( const char* path, int filter ) {
+    bool   is_new = false;
+    Asset* asset  = asset_acquire( AssetType::TEXTURE, path, &is_new );
+
+    if( is_new ) {
+        asset->filter = filter;
+        loader_push_texture( path, filter, &asset->texture );
+    } else if( asset->filter != filter && asset->texture.id ) {
+        asset->filter = filter;
+        SetTextureFilter( asset->texture, filter );
+    }
+
+    return &asset->texture;
+}
+void asset_texture_release( const Texture* texture ) {
+    if( auto* asset = asset_from_output( texture ) ) {
+        asset_release( asset );
+    }
+}
+
+Music* asset_music_acquire( const char* path ) {
+    bool   is_new = false;
+    Asset* asset  = asset_acquire( AssetType::MUSIC, path, &is_new );
+
+    if( is_new ) {
+        loader_push_music( path, &asset->music, &asset->music_data, &asset->music_data_size );
+    }
+
+    return &asset->music;
+}
+void asset_music_release( const Music* music ) {
+    if( auto* asset = asset_from_output( music ) ) {
+        asset_release( asset );
+    }
+}
+bool asset_music_is_ready( const Music* music ) {
+    return !loader_is_pending( music ) && IsMusicValid( *music );
+}
+
+AssetStats asset_stats() {
+    AssetStats result = {};
+    result.hits   = __ASSETS.hits;
+    result.misses = __ASSETS.misses;
+
+    for( const auto& asset : __ASSETS.assets ) {
+        if( asset.type == AssetType::NONE ) {
+            continue;
+        }
+
+        usize size = asset_size( &asset );
+
+        result.count++;
+        result.bytes += size;
+        if( !asset.refs ) {
+            result.unused_count++;
+            result.unused_bytes += size;
+        }
+    }
+
+    return result;
+}
+
+void asset_shutdown() {
+    loader_wait();
+    for( auto& asset : __ASSETS.assets ) {
+        if( asset.type != AssetType::NONE ) {
+            asset_unload( &asset );
+        }
+    }
+}
+
@@ -0,0 +1,332 @@
+/**
+ * @file   atlas.cpp
+ * @brief  Texture atlas.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 25, 2025
+*/
+#include "bog/atlas.h"
+#include "bog/collections.h"
+#include "bog/assets.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ATLAS_MAGIC   (0x41474F42) /* "BOGA" */
+#define ATLAS_VERSION (2)
+
+// NOTE(alicia): table is the header, one AtlasEntry per TEX_*
+// and then the texture filter of each page.
+// on demand textures are not packed and have page -1.
+struct AtlasTableHeader {
+    u32 magic;
+    u32 version;
+    u32 texture_count;
+    u32 page_count;
+};
+
+// NOTE(alicia): shelf packer, textures are placed left to right
+// in rows as tall as the first (tallest) texture of the row.
+struct AtlasPackPage {
+    int filter;
+
+    int shelf_x;
+    int shelf_y;
+    int shelf_height;
+};
+
+static bool atlas_pack_place( AtlasPackPage* page, int width, int height, int* out_x, int* out_y ) {
+    int padded_width  = width  + ATLAS_PADDING;
+    int padded_height = height + ATLAS_PADDING;
+
+    if( (page->shelf_x + width) > ATLAS_PAGE_SIZE ) {
+        page->shelf_y     += page->shelf_height;
+        page->shelf_x      = 0;
+        page->shelf_height = 0;
+    }
+    if( (page->shelf_x + width) > ATLAS_PAGE_SIZE || (page->shelf_y + height) > ATLAS_PAGE_SIZE ) {
+        return false;
+    }
+
+    *out_x = page->shelf_x;
+    *out_y = page->shelf_y;
+
+    page->shelf_x += padded_width;
+    if( padded_height > page->shelf_height ) {
+        page->shelf_height = padded_height;
+    }
+    return true;
+}
+
+bool atlas_pack() {
+    Image images[TEX_COUNT] = {};
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        if( TEXTURE_LOAD_PARAMS[i].is_on_demand ) {
+            continue;
+        }
+
+        images[i] = LoadImage( TEXTURE_LOAD_PARAMS[i].path );
+        if( !images[i].data ) {
+            fprintf( stderr, "ERROR: failed to load %s!\n", TEXTURE_LOAD_PARAMS[i].path );
+            for( int j = 0; j < i; ++j ) {
+                UnloadImage( images[j] );
+            }
+            return false;
+        }
+    }
+
+    // NOTE(alicia): tallest first so that shelves waste less space.
+    int order[TEX_COUNT];
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        order[i] = i;
+    }
+    for( int i = 1; i < TEX_COUNT; ++i ) {
+        int current = order[i];
+        int j       = i;
+        while( j > 0 && images[order[j - 1]].height < images[current].height ) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = current;
+    }
+
+    AtlasPackPage pack[TEX_COUNT] = {};
+    AtlasEntry    entries[TEX_COUNT] = {};
+    int           page_count = 0;
+    int           packed_count = 0;
+
+    bool result = true;
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        int    texture = order[i];
+        Image& image   = images[texture];
+        auto&  entry   = entries[texture];
+
+        if( TEXTURE_LOAD_PARAMS[texture].is_on_demand ) {
+            entry = { -1, 0, 0, 0, 0 };
+            continue;
+        }
+        packed_count++;
+
+        entry.width  = image.width;
+        entry.height = image.height;
+
+        if( image.width > ATLAS_PAGE_SIZE || image.height > ATLAS_PAGE_SIZE ) {
+            fprintf(
+                stderr, "ERROR: %s is larger than atlas page (%ix%i)!\n",
+                TEXTURE_LOAD_PARAMS[texture].path, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE );
+            result = false;
+            break;
+        }
+
+        // NOTE(alicia): filter is per texture so textures only
+        // share pages with textures that are filtered the same way.
+        entry.page = -1;
+        for( int page = 0; page < page_count; ++page ) {
+            if( pack[page].filter != TEXTURE_LOAD_PARAMS[texture].filter ) {
+                continue;
+            }
+            if( atlas_pack_place( pack + page, image.width, image.height, &entry.x, &entry.y ) ) {
+                entry.page = page;
+                break;
+            }
+        }
+
+        if( entry.page < 0 ) {
+            entry.page = page_count++;
+            pack[entry.page].filter = TEXTURE_LOAD_PARAMS[texture].filter;
+
+            atlas_pack_place( pack + entry.page, image.width, image.height, &entry.x, &entry.y );
+        }
+    }
+
+    for( int page = 0; result && page < page_count; ++page ) {
+        int height = 0;
+        for( int i = 0; i < TEX_COUNT; ++i ) {
+            if( entries[i].page == page && (entries[i].y + entries[i].height) > height ) {
+                height = entries[i].y + entries[i].height;
+            }
+        }
+
+        Image out = GenImageColor( ATLAS_PAGE_SIZE, height, BLANK );
+        for( int i = 0; i < TEX_COUNT; ++i ) {
+            const auto& entry = entries[i];
+            if( entry.page != page ) {
+                continue;
+            }
+
+            Rectangle src = { 0, 0, (float)entry.width, (float)entry.height };
+            Rectangle dst = { (float)entry.x, (float)entry.y, src.width, src.height };
+            ImageDraw( &out, images[i], src, dst, WHITE );
+        }
+
+        const char* path = TextFormat( ATLAS_PAGE_PATH, page );
+        if( !ExportImage( out, path ) ) {
+            fprintf( stderr, "ERROR: failed to write %s!\n", path );
+            result = false;
+        } else {
+            printf( "%s (%ix%i)\n", path, ATLAS_PAGE_SIZE, height );
+        }
+
+        UnloadImage( out );
+    }
+
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        UnloadImage( images[i] );
+    }
+
+    if( !result ) {
+        return false;
+    }
+
+    AtlasTableHeader header = {};
+    header.magic         = ATLAS_MAGIC;
+    header.version       = ATLAS_VERSION;
+    header.texture_count = TEX_COUNT;
+    header.page_count    = page_count;
+
+    List<char> out = {};
+    out.append( sizeof(header), (const char*)&header );
+    out.append( sizeof(entries), (const char*)entries );
+    for( int page = 0; page < page_count; ++page ) {
+        out.append( sizeof(int), (const char*)&pack[page].filter );
+    }
+
+    result = SaveFileData( ATLAS_TABLE_PATH, out.buf, out.len );
+    out.free();
+
+    if( result ) {
+        printf( "%i textures -> %i page(s), %s\n", packed_count, page_count, ATLAS_TABLE_PATH );
+    }
+    return result;
+}
+
+// NOTE(alicia): packed textures are compared against oldest of table and pages,
+// on demand textures are not in atlas so changing them does not make it stale.
+static bool atlas_is_stale() {
+    long packed_time = GetFileModTime( ATLAS_TABLE_PATH );
+    for( int page = 0; page < TEX_COUNT; ++page ) {
+        const char* path = TextFormat( ATLAS_PAGE_PATH, page );
+        if( !FileExists( path ) ) {
+            break;
+        }
+
+        long page_time = GetFileModTime( path );
+        if( page_time < packed_time ) {
+            packed_time = page_time;
+        }
+    }
+
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        if( TEXTURE_LOAD_PARAMS[i].is_on_demand ) {
+            continue;
+        }
+        if( GetFileModTime( TEXTURE_LOAD_PARAMS[i].path ) > packed_time ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool atlas_load_packed( TextureAtlas* out ) {
+    int   size = 0;
+    auto* data = LoadFileData( ATLAS_TABLE_PATH, &size );
+    if( !data ) {
+        return false;
+    }
+
+    auto* header  = (AtlasTableHeader*)data;
+    auto* entries = (AtlasEntry*)(header + 1);
+    auto* filters = (int*)(entries + TEX_COUNT);
+
+    bool is_valid =
+        size >= (int)sizeof(AtlasTableHeader)  &&
+        header->magic         == ATLAS_MAGIC   &&
+        header->version       == ATLAS_VERSION &&
+        header->texture_count == TEX_COUNT     &&
+        header->page_count    >= 1             &&
+        header->page_count    <= TEX_COUNT     &&
+        size == (int)(sizeof(AtlasTableHeader) + sizeof(AtlasEntry) * TEX_COUNT + sizeof(int) * header->page_count);
+
+    for( int i = 0; is_valid && i < TEX_COUNT; ++i ) {
+        if( TEXTURE_LOAD_PARAMS[i].is_on_demand ) {
+            is_valid = entries[i].page == -1;
+        } else {
+            is_valid = entries[i].page >= 0 && entries[i].page < (int)header->page_count;
+        }
+    }
+    for( int page = 0; is_valid && page < (int)header->page_count; ++page ) {
+        is_valid = FileExists( TextFormat( ATLAS_PAGE_PATH, page ) );
+    }
+
+    if( is_valid ) {
+        out->page_count = header->page_count;
+        memcpy( out->entries, entries, sizeof(out->entries) );
+
+        for( int page = 0; page < out->page_count; ++page ) {
+            out->pages[page] = asset_texture_acquire( TextFormat( ATLAS_PAGE_PATH, page ), filters[page] );
+        }
+
+        // NOTE(alicia): on demand textures get a page each after packed pages.
+        for( int i = 0; i < TEX_COUNT; ++i ) {
+            if( TEXTURE_LOAD_PARAMS[i].is_on_demand ) {
+                out->entries[i] = { out->page_count++, 0, 0, 0, 0 };
+            }
+        }
+    }
+
+    UnloadFileData( data );
+    return is_valid;
+}
+
+void atlas_load( TextureAtlas* out ) {
+    *out = {};
+
+    if( FileExists( ATLAS_TABLE_PATH ) ) {
+        if( atlas_is_stale() ) {
+            TraceLog( LOG_WARNING, "%s: atlas is older than textures, run -pack-atlas.", ATLAS_TABLE_PATH );
+        } else if( atlas_load_packed( out ) ) {
+            out->is_packed = true;
+            return;
+        } else {
+            TraceLog( LOG_WARNING, "%s: atlas is invalid, loading textures instead.", ATLAS_TABLE_PATH );
+        }
+    }
+
+    // NOTE(alicia): size of each texture is not known until it is loaded,
+    // full texture sprites read it from the page instead.
+    out->page_count = TEX_COUNT;
+    for( int i = 0; i < TEX_COUNT; ++i ) {
+        out->entries[i] = { i, 0, 0, 0, 0 };
+        if( !TEXTURE_LOAD_PARAMS[i].is_on_demand ) {
+            atlas_require( out, i );
+        }
+    }
+}
+void atlas_unload( TextureAtlas* atlas ) {
+    for( int page = 0; page < atlas->page_count; ++page ) {
+        if( atlas->pages[page] ) {
+            asset_texture_release( atlas->pages[page] );
+        }
+    }
+    *atlas = {};
+}
+
+// NOTE(alicia): only textures that have a page to themselves
+// are acquired and released individually.
+void atlas_require( TextureAtlas* atlas, int texture ) {
+    auto& page = atlas->pages[atlas->entries[texture].page];
+    if( !page ) {
+        const auto& params = TEXTURE_LOAD_PARAMS[texture];
+        page = asset_texture_acquire( params.path, params.filter );
+    }
+}
+void atlas_release( TextureAtlas* atlas, int texture ) {
+    if( !TEXTURE_LOAD_PARAMS[texture].is_on_demand ) {
+        return;
+    }
+
+    auto& page = atlas->pages[atlas->entries[texture].page];
+    if( page ) {
+        asset_texture_release( page );
+        page = nullptr;
+    }
+}
+
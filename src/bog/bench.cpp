@@ -0,0 +1,656 @@
+/**
+ * @file   bench.cpp
+ * @brief  Benchmarks.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 20, 2025
+*/
+#include "bog/bench.h"
+#include "bog/collections.h"
+#include "bog/scene.h"
+#include "bog/scenes.h"
+#include "bog/animation.h"
+#include "bog/ui.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+static double bench_time() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>( now ).count();
+}
+
+struct BenchResult {
+    double min, total;
+    int    iterations;
+};
+
+// NOTE(alicia): runs fn at least min_iterations times and for at least min_seconds.
+template<typename Fn>
+static BenchResult bench_measure( int min_iterations, double min_seconds, Fn fn ) {
+    BenchResult result = {};
+    result.min = 1.0 / 0.0;
+
+    double start = bench_time();
+    while( result.iterations < min_iterations || (bench_time() - start) < min_seconds ) {
+        double t = bench_time();
+        fn();
+        t = bench_time() - t;
+
+        if( t < result.min ) {
+            result.min = t;
+        }
+        result.total += t;
+        result.iterations++;
+    }
+
+    return result;
+}
+
+static void bench_report( const char* name, BenchResult result, int bytes, int items ) {
+    double avg = result.total / result.iterations;
+    printf(
+        "  %-24s min %10.3fms  avg %10.3fms  %8.1f MB/s  %10.0f items/s  (%i runs)\n",
+        name, result.min * 1000.0, avg * 1000.0,
+        (bytes / (1024.0 * 1024.0)) / result.min,
+        items / result.min,
+        result.iterations );
+}
+
+// NOTE(alicia): scene ----------------------------------------------------------------
+
+static void bench_generate_scene( List<char>* out, int node_count ) {
+    auto append = [out]( const char* text ) {
+        out->append( strlen( text ), text );
+    };
+
+    append( "{\n    \"id\": 1,\n    \"title\": \"Synthetic\",\n    \"tree\": [\n" );
+
+    for( int i = 0; i < node_count; ++i ) {
+        if( i ) {
+            append( ",\n" );
+        }
+
+        // NOTE(alicia): roughly the same mix of nodes as scene-01.
+        switch( i % 20 ) {
+            case 0: {
+                append( TextFormat(
+                    "        // NOTE: node %i\n"
+                    "        { \"type\": \"write\", \"id\": %i, \"write.key\": \"bg\", \"write.value\": %i }",
+                    i, i, i % 6 ) );
+            } break;
+            case 1: {
+                append( TextFormat(
+                    "        { \"type\": \"fade\", \"id\": %i, \"fade.reverse\": %s }",
+                    i, (i % 40) == 1 ? "true" : "false" ) );
+            } break;
+            case 2: {
+                append( TextFormat(
+                    "        { \"type\": \"control\", \"id\": %i, \"control.type\": \"conditional\",\n"
+                    "          \"control.conditional.key\": \"visited-%i\",\n"
+                    "          \"control.conditional.false\": { \"node\": %i },\n"
+                    "          \"control.conditional.true\": {} }",
+                    i, i % 7, i + 3 ) );
+            } break;
+            case 3: if( (i % 100) == 3 ) {
+                append( TextFormat(
+                    "        { \"type\": \"fork\", \"id\": %i, \"fork.options\": [\n"
+                    "            { \"text\": \"Yes\", \"action\": \"write\", \"write.key\": \"choice-%i\", \"write.value\": 1 },\n"
+                    "            { \"text\": \"No\", \"action\": \"jump\", \"jump.node\": %i }\n"
+                    "        ] }",
+                    i, i, i + 1 ) );
+                break;
+            } [[fallthrough]];
+            default: {
+                append( TextFormat(
+                    "        {\n"
+                    "            \"type\": \"story\",\n"
+                    "            \"id\": %i,\n"
+                    "            \"story.text\": \"Line %i. <rgba:ff,42,42,ff>Zuma<rgba:ff,ff,ff,ff> says \\\"hello\\\" to everyone in the room.\",\n"
+                    "            \"story.character\": \"<rgba:ff,42,42,ff>Zuma<rgba:ff,ff,ff,ff>\",\n"
+                    "            \"story.animation.side\": \"%s\",\n"
+                    "            \"story.animation.name\": \"%s\"\n"
+                    "        }",
+                    i, i,
+                    (i & 1) ? "left" : "right",
+                    (i & 1) ? "zuma" : "jade_base" ) );
+            } break;
+        }
+    }
+
+    append( "\n    ]\n}\n" );
+}
+
+static void bench_scene_parse( const char* name, String source ) {
+    Scene scene = {};
+
+    // NOTE(alicia): warm up, also gives node count for report.
+    scene_parse( name, source, &scene );
+    int node_count = scene.node_count();
+
+    auto result = bench_measure( 5, 1.0, [&]() {
+        scene_parse( name, source, &scene );
+    } );
+    bench_report( name, result, source.len, node_count );
+
+    usize node_bytes = scene_node_bytes( &scene );
+    printf(
+        "  %-24s %i nodes in %llu bytes (%.1f bytes/node)\n",
+        "", node_count, (unsigned long long)node_bytes,
+        node_count ? (double)node_bytes / node_count : 0.0 );
+
+    scene.free();
+}
+
+static void bench_scene() {
+    const char* path = "resources/scenes/scene-01.json";
+
+    int   size = 0;
+    char* data = (char*)LoadFileData( path, &size );
+    if( data ) {
+        bench_scene_parse( "scene-01.json", String( size, data ) );
+        UnloadFileData( (unsigned char*)data );
+    } else {
+        printf( "  %s: not found, skipped.\n", path );
+    }
+
+    List<char> synthetic = {};
+    bench_generate_scene( &synthetic, 100000 );
+
+    bench_scene_parse( "synthetic-100k.json", String( synthetic.len, synthetic.buf ) );
+
+    synthetic.free();
+}
+
+// NOTE(alicia): jump into first scene, cold jumps list and load scenes again
+// while warm jumps find scene already loaded in scene cache.
+static void bench_scenes() {
+    _readonly int JUMPS = 1000;
+
+    int first = scenes_first();
+    if( first < 0 ) {
+        printf( "  %s: no scenes found, skipped.\n", SCENE_DIRECTORY );
+        return;
+    }
+
+    auto cold = bench_measure( 5, 0.5, [&]() {
+        scenes_shutdown();
+        scenes_release( scenes_acquire( first ) );
+    } );
+    bench_report( "scene jump cold", cold, 0, 1 );
+
+    auto warm = bench_measure( 10, 0.25, [&]() {
+        for( int i = 0; i < JUMPS; ++i ) {
+            scenes_release( scenes_acquire( first ) );
+        }
+    } );
+    bench_report( "scene jump warm", warm, 0, JUMPS );
+
+    scenes_shutdown();
+}
+
+// NOTE(alicia): lookup ---------------------------------------------------------------
+
+// NOTE(alicia): reference implementations, same as lookups were before perfect hashing.
+static bool bench_animation_from_string_linear( String string, int* out ) {
+    for( int i = ANIM_NONE + 1; i < ANIM_COUNT; ++i ) {
+        if( string_cmp( string, string_from_animation( i ) ) ) {
+            *out = i;
+            return true;
+        }
+    }
+    return false;
+}
+static bool bench_node_type_from_string_linear( String string, NodeType* out ) {
+    for( int i = 0; i < (int)NodeType::COUNT; ++i ) {
+        if( string_cmp( string, string_from_node_type( (NodeType)i ) ) ) {
+            *out = (NodeType)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Fn>
+static void bench_lookup_names( const char* name, int count, const String* names, Fn fn ) {
+    _readonly int ROUNDS = 1000;
+
+    int bytes = 0;
+    for( int i = 0; i < count; ++i ) {
+        bytes += names[i].len;
+    }
+
+    volatile int sink = 0;
+    BenchResult result = bench_measure( 10, 0.25, [&]() {
+        int sum = 0;
+        for( int round = 0; round < ROUNDS; ++round ) {
+            for( int i = 0; i < count; ++i ) {
+                sum += fn( names[i] );
+            }
+        }
+        sink = sink + sum;
+    } );
+
+    bench_report( name, result, bytes * ROUNDS, count * ROUNDS );
+}
+
+static void bench_lookup() {
+    // NOTE(alicia): every name plus a few that are not found.
+    String animations[ANIM_COUNT + 2] = {};
+    int    animation_count = 0;
+    for( int i = ANIM_NONE + 1; i < ANIM_COUNT; ++i ) {
+        animations[animation_count++] = string_from_animation( i );
+    }
+    animations[animation_count++] = "jade";
+    animations[animation_count++] = "jade_creepiest_neutral_exp_";
+    animations[animation_count++] = "unknown";
+
+    String node_types[(int)NodeType::COUNT + 2] = {};
+    int    node_type_count = 0;
+    for( int i = 0; i < (int)NodeType::COUNT; ++i ) {
+        node_types[node_type_count++] = string_from_node_type( (NodeType)i );
+    }
+    node_types[node_type_count++] = "forks";
+    node_types[node_type_count++] = "unknown";
+
+    bench_lookup_names( "animation linear", animation_count, animations, []( String name ) {
+        int out = 0;
+        bench_animation_from_string_linear( name, &out );
+        return out;
+    } );
+    bench_lookup_names( "animation perfect hash", animation_count, animations, []( String name ) {
+        int out = 0;
+        animation_from_string( name, &out );
+        return out;
+    } );
+    bench_lookup_names( "node type linear", node_type_count, node_types, []( String name ) {
+        NodeType out = NodeType::NONE;
+        bench_node_type_from_string_linear( name, &out );
+        return (int)out;
+    } );
+    bench_lookup_names( "node type perfect hash", node_type_count, node_types, []( String name ) {
+        NodeType out = NodeType::NONE;
+        node_type_from_string( name, &out );
+        return (int)out;
+    } );
+}
+
+// NOTE(alicia): text -----------------------------------------------------------------
+
+// dialogue corpus is every story text in scene-01,
+// long corpus is all of it joined into one string.
+struct BenchTextCorpus {
+    Scene        scene;
+    List<String> lines;
+    List<char>   all;
+};
+
+static bool bench_text_corpus( BenchTextCorpus* out ) {
+    const char* path = "resources/scenes/scene-01.json";
+    if( !FileExists( path ) ) {
+        return false;
+    }
+    scene_load( path, &out->scene );
+
+    for( int i = 0; i < out->scene.node_count(); ++i ) {
+        Node node = out->scene.node( i );
+        if( node.type != NodeType::STORY || !node.story->text.len ) {
+            continue;
+        }
+
+        String text = node.story->text.to_string( out->scene.string );
+        out->lines.push( text );
+
+        out->all.append( text.len, text.buf );
+        out->all.push( '\n' );
+    }
+    return true;
+}
+
+// NOTE(alicia): compares every level against scalar from every offset of text.
+static int bench_text_verify( String text ) {
+    _readonly char CHARS[] = { '<', '>', ' ', '\n' };
+    _readonly const char* SETS[] = { " \n", "<>", "?!.", "\t" };
+    _readonly const char* SUBSTRINGS[] = { "rgba:", "the", "!?", "> ", "never found" };
+
+    int mismatches = 0;
+    auto compare = [&]( bool a, int a_index, bool b, int b_index ) {
+        if( a != b || (a && a_index != b_index) ) {
+            mismatches++;
+        }
+    };
+
+    for( int level = (int)SimdLevel::SCALAR + 1; level < (int)SimdLevel::COUNT; ++level ) {
+        if( !simd_level_is_supported( (SimdLevel)level ) ) {
+            continue;
+        }
+
+        for( int offset = 0; offset < text.len; ++offset ) {
+            String rest = advance( text, offset );
+
+            for( char c : CHARS ) {
+                int a_index = -1, b_index = -1;
+                bool a = find_char_simd( SimdLevel::SCALAR, rest, c, &a_index );
+                bool b = find_char_simd( (SimdLevel)level, rest, c, &b_index );
+                compare( a, a_index, b, b_index );
+            }
+            for( const char* set : SETS ) {
+                int a_index = -1, b_index = -1;
+                bool a = find_set_simd( SimdLevel::SCALAR, rest, String( set ), &a_index );
+                bool b = find_set_simd( (SimdLevel)level, rest, String( set ), &b_index );
+                compare( a, a_index, b, b_index );
+            }
+            for( const char* substring : SUBSTRINGS ) {
+                int a_index = -1, b_index = -1;
+                bool a = find_string_simd(
+                    SimdLevel::SCALAR, rest, String( substring ), &a_index );
+                bool b = find_string_simd(
+                    (SimdLevel)level, rest, String( substring ), &b_index );
+                compare( a, a_index, b, b_index );
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+template<typename Fn>
+static void bench_text_scan(
+    const char* name, SimdLevel level, Slice<String> lines, Fn fn
+) {
+    _readonly int ROUNDS = 100;
+
+    int bytes = 0;
+    for( int i = 0; i < lines.len; ++i ) {
+        bytes += lines[i].len;
+    }
+
+    volatile int sink = 0;
+    BenchResult result = bench_measure( 10, 0.25, [&]() {
+        int sum = 0;
+        for( int round = 0; round < ROUNDS; ++round ) {
+            // NOTE(alicia): scans of unchanged text must not be hoisted out of rounds.
+            __asm__ volatile( "" ::: "memory" );
+            for( int i = 0; i < lines.len; ++i ) {
+                sum += fn( level, lines[i] );
+            }
+        }
+        sink = sink + sum;
+    } );
+
+    bench_report(
+        TextFormat( "%s %s", name, string_from_simd_level( level ).buf ),
+        result, bytes * ROUNDS, lines.len * ROUNDS );
+}
+
+// NOTE(alicia): words and commands do what text_split_words does to a line,
+// line and long scans look for what is not there to measure throughput.
+static void bench_text() {
+    BenchTextCorpus corpus = {};
+    if( !bench_text_corpus( &corpus ) ) {
+        printf( "  resources/scenes/scene-01.json: not found, skipped.\n" );
+        return;
+    }
+
+    printf( "  simd level: %s\n", string_from_simd_level( simd_level() ).buf );
+
+    // NOTE(alicia): lines are verified from copies that end where line ends
+    // so that reading past end of a line shows up under address sanitizer.
+    int mismatches = 0;
+    for( int i = 0; i < corpus.lines.len; ++i ) {
+        String line = corpus.lines[i];
+        char*  copy = mem_alloc<char>( line.len );
+        memcpy( copy, line.buf, line.len );
+
+        mismatches += bench_text_verify( String( line.len, copy ) );
+
+        mem_free( copy, line.len );
+    }
+    printf(
+        "  %i line(s), %i bytes, %i mismatch(es) against scalar\n",
+        corpus.lines.len, corpus.all.len, mismatches );
+
+    Slice<String> lines = { corpus.lines.len, corpus.lines.buf };
+    String        all   = { corpus.all.len, corpus.all.buf };
+    Slice<String> long_lines = { 1, &all };
+
+    for( int level = 0; level < (int)SimdLevel::COUNT; ++level ) {
+        if( !simd_level_is_supported( (SimdLevel)level ) ) {
+            continue;
+        }
+
+        bench_text_scan( "words", (SimdLevel)level, lines, []( SimdLevel level, String line ) {
+            int sum   = 0;
+            int index = 0;
+            while( find_set_simd( level, line, " \n", &index ) ) {
+                sum += index;
+                line = advance( line, index + 1 );
+            }
+            return sum;
+        } );
+        bench_text_scan( "commands", (SimdLevel)level, lines, []( SimdLevel level, String line ) {
+            int start = 0, end = 0;
+            if( !find_char_simd( level, line, '<', &start ) ) {
+                return 0;
+            }
+            find_char_simd( level, line, '>', &end );
+            return end + find_string_simd( level, line, "rgba:" );
+        } );
+        bench_text_scan( "line char", (SimdLevel)level, lines, []( SimdLevel level, String line ) {
+            return (int)find_char_simd( level, line, '~' );
+        } );
+        bench_text_scan( "line set", (SimdLevel)level, lines, []( SimdLevel level, String line ) {
+            return (int)find_set_simd( level, line, "~\t" );
+        } );
+        bench_text_scan( "long char", (SimdLevel)level, long_lines, []( SimdLevel level, String line ) {
+            return (int)find_char_simd( level, line, '~' );
+        } );
+        bench_text_scan( "long set", (SimdLevel)level, long_lines, []( SimdLevel level, String line ) {
+            return (int)find_set_simd( level, line, "~\t" );
+        } );
+        bench_text_scan( "long string", (SimdLevel)level, long_lines, []( SimdLevel level, String line ) {
+            return (int)find_string_simd( level, line, "never found" );
+        } );
+    }
+
+    corpus.lines.free();
+    corpus.all.free();
+    corpus.scene.free();
+}
+
+// NOTE(alicia): glyphs ---------------------------------------------------------------
+
+// made up font with glyphs sorted by codepoint like LoadFontEx,
+// ASCII then Latin-1 then CJK ideographs. only metrics are used to measure text.
+struct BenchFont {
+    Font font;
+
+    void free() {
+        mem_free( font.glyphs, font.glyphCount );
+        mem_free( font.recs, font.glyphCount );
+        font = {};
+    }
+};
+
+static BenchFont bench_font_generate( int glyph_count, u32 texture_id ) {
+    BenchFont result = {};
+
+    result.font.baseSize     = 28;
+    result.font.glyphCount   = glyph_count;
+    result.font.glyphs       = mem_alloc<GlyphInfo>( glyph_count );
+    result.font.recs         = mem_alloc<Rectangle>( glyph_count );
+    result.font.texture.id   = texture_id;
+
+    int codepoint = ' ';
+    for( int i = 0; i < glyph_count; ++i ) {
+        auto* glyph = result.font.glyphs + i;
+        glyph->value    = codepoint;
+        glyph->offsetX  = i % 3;
+        glyph->advanceX = (i % 13) ? 8 + (i % 9) : 0;
+        result.font.recs[i].width  = 10 + (i % 5);
+        result.font.recs[i].height = 28;
+
+        codepoint++;
+        if( codepoint == 0x7F ) {
+            codepoint = 0xA0;
+        } else if( codepoint == 0x100 ) {
+            codepoint = 0x4E00;
+        }
+    }
+
+    return result;
+}
+
+// NOTE(alicia): same lines with everything but white space swapped for ideographs,
+// strings are null terminated for MeasureTextEx.
+static void bench_glyphs_corpus(
+    Slice<String> lines, bool localised, List<char>* out_text, List<String>* out_lines
+) {
+    List<int> offsets = {};
+
+    for( int i = 0; i < lines.len; ++i ) {
+        String line = lines[i];
+        offsets.push( out_text->len );
+
+        for( int j = 0; j < line.len; ++j ) {
+            char c = line[j];
+            if( !localised || c == ' ' || c == '\n' ) {
+                out_text->push( c );
+                continue;
+            }
+
+            int size = 0;
+            const char* utf8 = CodepointToUTF8( 0x4E00 + ((u8)c * 31) % 3000, &size );
+            out_text->append( size, utf8 );
+        }
+        out_text->push( 0 );
+    }
+
+    for( int i = 0; i < offsets.len; ++i ) {
+        int end = (i + 1) < offsets.len ? offsets[i + 1] : out_text->len;
+        out_lines->push( String( end - offsets[i] - 1, out_text->buf + offsets[i] ) );
+    }
+
+    offsets.free();
+}
+
+static void bench_glyphs() {
+    BenchTextCorpus corpus = {};
+    if( !bench_text_corpus( &corpus ) ) {
+        printf( "  resources/scenes/scene-01.json: not found, skipped.\n" );
+        return;
+    }
+
+    _readonly int FONT_GLYPH_COUNTS[] = { 96, 4000 };
+    _readonly int ROUNDS = 10;
+
+    Slice<String> corpus_lines = { corpus.lines.len, corpus.lines.buf };
+
+    for( int localised = 0; localised < 2; ++localised ) {
+        List<char>   text  = {};
+        List<String> lines = {};
+        bench_glyphs_corpus( corpus_lines, localised, &text, &lines );
+
+        int bytes = 0;
+        for( int i = 0; i < lines.len; ++i ) {
+            bytes += lines[i].len;
+        }
+
+        for( int glyph_count : FONT_GLYPH_COUNTS ) {
+            BenchFont font = bench_font_generate( glyph_count, 1 + glyph_count );
+            float size     = font.font.baseSize;
+
+            // NOTE(alicia): glyph tables must measure exactly what raylib does.
+            int mismatches = 0;
+            for( int i = 0; i < lines.len; ++i ) {
+                Vector2 a = MeasureTextEx( font.font, lines[i].buf, size, 1.0f );
+                Vector2 b = text_measure_slice( font.font, lines[i], size, 1.0f );
+                if( a.x != b.x || a.y != b.y ) {
+                    mismatches++;
+                }
+            }
+            printf(
+                "  %s text, %i glyph font: %i line(s), %i mismatch(es) against MeasureTextEx\n",
+                localised ? "localised" : "dialogue", glyph_count, lines.len, mismatches );
+
+            volatile float sink = 0.0f;
+            BenchResult raylib = bench_measure( 3, 0.25, [&]() {
+                float sum = 0.0f;
+                for( int round = 0; round < ROUNDS; ++round ) {
+                    for( int i = 0; i < lines.len; ++i ) {
+                        sum += MeasureTextEx( font.font, lines[i].buf, size, 1.0f ).x;
+                    }
+                }
+                sink = sink + sum;
+            } );
+            BenchResult table = bench_measure( 3, 0.25, [&]() {
+                float sum = 0.0f;
+                for( int round = 0; round < ROUNDS; ++round ) {
+                    for( int i = 0; i < lines.len; ++i ) {
+                        sum += text_measure_slice( font.font, lines[i], size, 1.0f ).x;
+                    }
+                }
+                sink = sink + sum;
+            } );
+
+            bench_report( "MeasureTextEx", raylib, bytes * ROUNDS, lines.len * ROUNDS );
+            bench_report( "text_measure_slice", table, bytes * ROUNDS, lines.len * ROUNDS );
+
+            font.free();
+        }
+
+        text.free();
+        lines.free();
+    }
+
+    corpus.lines.free();
+    corpus.all.free();
+    corpus.scene.free();
+}
+
+// NOTE(alicia): runner ----------------------------------------------------------------
+
+_readonly Benchmark BENCHMARKS[] = {
+    { "scene", bench_scene },
+    { "scenes", bench_scenes },
+    { "lookup", bench_lookup },
+    { "text", bench_text },
+    { "glyphs", bench_glyphs },
+};
+
+int bench_run( int count, char** names ) {
+    for( int i = 0; i < count; ++i ) {
+        bool found = false;
+        for( size_t j = 0; j < ARRAY_LEN(BENCHMARKS); ++j ) {
+            if( strcmp( names[i], BENCHMARKS[j].name ) == 0 ) {
+                found = true;
+                break;
+            }
+        }
+        if( !found ) {
+            fprintf( stderr, "ERROR: unrecognized benchmark '%s'!\n", names[i] );
+            return 1;
+        }
+    }
+
+    for( size_t i = 0; i < ARRAY_LEN(BENCHMARKS); ++i ) {
+        bool should_run = !count;
+        for( int j = 0; j < count; ++j ) {
+            if( strcmp( names[j], BENCHMARKS[i].name ) == 0 ) {
+                should_run = true;
+                break;
+            }
+        }
+
+        if( should_run ) {
+            printf( "%s:\n", BENCHMARKS[i].name );
+            BENCHMARKS[i].run();
+        }
+    }
+
+    return 0;
+}
@@ -43,6 +43,70 @@ StringOffset string_offset_push(
     return result;
 }
 
+u32 string_hash( String string ) {
+    // NOTE(alicia): FNV-1a
+    u32 hash = 2166136261u;
+    for( int i = 0; i < string.len; ++i ) {
+        hash ^= (u8)string[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int InternTable::find( String key ) const {
+    if( !slots.len ) {
+        return -1;
+    }
+
+    u32 mask = slots.len - 1;
+    for( u32 i = string_hash( key ) & mask;; i = (i + 1) & mask ) {
+        int slot = slots[i];
+        if( !slot ) {
+            return -1;
+        }
+        if( string_cmp( get( slot - 1 ), key ) ) {
+            return slot - 1;
+        }
+    }
+}
+
+int InternTable::intern( String key ) {
+    int id = find( key );
+    if( id >= 0 ) {
+        return id;
+    }
+
+    // NOTE(alicia): keep load factor at or below 1/2.
+    if( ((strings.len + 1) * 2) > slots.len ) {
+        int new_len = slots.len ? slots.len * 2 : MINIMUM_ALLOC_COUNT;
+
+        slots.reset();
+        slots.reserve( new_len );
+        slots.len = new_len;
+        memset( slots.buf, 0, sizeof(int) * slots.len );
+
+        u32 mask = slots.len - 1;
+        for( int i = 0; i < strings.len; ++i ) {
+            u32 at = string_hash( get( i ) ) & mask;
+            while( slots[at] ) {
+                at = (at + 1) & mask;
+            }
+            slots[at] = i + 1;
+        }
+    }
+
+    id = strings.push( string_offset_push( &string, key ) );
+
+    u32 mask = slots.len - 1;
+    u32 at   = string_hash( key ) & mask;
+    while( slots[at] ) {
+        at = (at + 1) & mask;
+    }
+    slots[at] = id + 1;
+
+    return id;
+}
+
 bool string_cmp( String a, String b ) {
     if( a.len != b.len ) {
         return false;
@@ -50,47 +114,412 @@ bool string_cmp( String a, String b ) {
     return memcmp( a.buf, b.buf, a.len ) == 0;
 }
 
-bool find_char( String string, char c, int* opt_out_index ) {
-    const char* result = (const char*)memchr( string.buf, c, string.len );
-    if( !result ) {
-        return false;
-    }
+// NOTE(alicia): simd ------------------------------------------------------------------
+// every scan returns index of first match or -1 and never loads past end of string.
 
-    if( opt_out_index ) {
-        *opt_out_index = result - string.buf;
+// NOTE(alicia): memchr is what find_char used before vector scans
+// and it is what builds without them still get.
+static int find_char_scalar( const char* buf, int from, int len, char c ) {
+    if( from >= len ) {
+        return -1;
     }
-    return true;
+    const char* result = (const char*)memchr( buf + from, c, len - from );
+    return result ? (int)(result - buf) : -1;
 }
-bool find_set( String string, String set, int* opt_out_index ) {
-    for( int i = 0; i < string.len; ++i ) {
+static int find_set_scalar( const char* buf, int from, int len, String set ) {
+    for( int i = from; i < len; ++i ) {
         for( int j = 0; j < set.len; ++j ) {
-            if( string[i] == set[j] ) {
-                if( opt_out_index ) {
-                    *opt_out_index = i;
-                }
-                return true;
+            if( buf[i] == set[j] ) {
+                return i;
             }
         }
     }
+    return -1;
+}
+// NOTE(alicia): empty substring is found at start of any string that is not empty.
+static int find_string_scalar( const char* buf, int from, int len, String substring ) {
+    for( int i = from; i < len && (len - i) >= substring.len; ++i ) {
+        if( memcmp( buf + i, substring.buf, substring.len ) == 0 ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* sets longer than this are scanned with scalar loop */
+#define SIMD_SET_MAX (4)
+
+// NOTE(alicia): text_split_words finds the next space every few bytes,
+// setting up vector compares costs more than that, so vector levels
+// scan this many bytes with scalar loop before they start.
+#define SIMD_SCALAR_HEAD (32)
+
+// NOTE(alicia): vector scans compare every byte against four set characters,
+// shorter sets repeat their first character. set must not be empty.
+static char simd_set_char( String set, int index ) {
+    return index < set.len ? set[index] : set[0];
+}
+
+// NOTE(alicia): strings shorter than one block are scanned by scalar loop.
+// last block of a longer string is loaded so that it ends where string ends,
+// it overlaps bytes that were already scanned so those are masked off.
+#if defined(__SSE2__)
+#define SIMD_X86
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define SIMD_AVX2
+    #define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static int find_char_sse2( const char* buf, int len, char c ) {
+    if( len < 16 ) {
+        return find_char_scalar( buf, 0, len, c );
+    }
+    __m128i needle = _mm_set1_epi8( c );
+
+    int i = 0;
+    for( ; (i + 16) < len; i += 16 ) {
+        __m128i block = _mm_loadu_si128( (const __m128i*)(buf + i) );
+
+        int mask = _mm_movemask_epi8( _mm_cmpeq_epi8( block, needle ) );
+        if( mask ) {
+            return i + __builtin_ctz( mask );
+        }
+    }
+
+    int     last  = len - 16;
+    __m128i block = _mm_loadu_si128( (const __m128i*)(buf + last) );
+
+    int mask = _mm_movemask_epi8( _mm_cmpeq_epi8( block, needle ) ) & (0xFFFF << (i - last));
+    return mask ? last + __builtin_ctz( mask ) : -1;
+}
+
+static int find_set_sse2( const char* buf, int len, String set ) {
+    if( len < 16 ) {
+        return find_set_scalar( buf, 0, len, set );
+    }
+
+    __m128i a     = _mm_set1_epi8( simd_set_char( set, 0 ) );
+    __m128i b     = _mm_set1_epi8( simd_set_char( set, 1 ) );
+    __m128i c     = _mm_set1_epi8( simd_set_char( set, 2 ) );
+    __m128i d     = _mm_set1_epi8( simd_set_char( set, 3 ) );
+    auto    match = [&]( int at ) -> int {
+        __m128i block = _mm_loadu_si128( (const __m128i*)(buf + at) );
+        return _mm_movemask_epi8( _mm_or_si128(
+            _mm_or_si128( _mm_cmpeq_epi8( block, a ), _mm_cmpeq_epi8( block, b ) ),
+            _mm_or_si128( _mm_cmpeq_epi8( block, c ), _mm_cmpeq_epi8( block, d ) ) ) );
+    };
+
+    int i = 0;
+    for( ; (i + 16) < len; i += 16 ) {
+        int mask = match( i );
+        if( mask ) {
+            return i + __builtin_ctz( mask );
+        }
+    }
+
+    int last = len - 16;
+    int mask = match( last ) & (0xFFFF << (i - last));
+    return mask ? last + __builtin_ctz( mask ) : -1;
+}
+
+// NOTE(alicia): blocks are compared against first and last character of substring,
+// only offsets where both match are compared in full.
+static int find_string_sse2_candidates( const char* buf, int at, int mask, String substring ) {
+    while( mask ) {
+        int offset = at + __builtin_ctz( mask );
+        if( memcmp( buf + offset + 1, substring.buf + 1, substring.len - 2 ) == 0 ) {
+            return offset;
+        }
+        mask &= mask - 1;
+    }
+    return -1;
+}
+static int find_string_sse2( const char* buf, int len, String substring ) {
+    int last_offset = substring.len - 1;
+    if( (len - last_offset) < 16 ) {
+        return find_string_scalar( buf, 0, len, substring );
+    }
+
+    __m128i first = _mm_set1_epi8( substring[0] );
+    __m128i last  = _mm_set1_epi8( substring[last_offset] );
+    auto    match = [&]( int at ) -> int {
+        __m128i block_first = _mm_loadu_si128( (const __m128i*)(buf + at) );
+        __m128i block_last  = _mm_loadu_si128( (const __m128i*)(buf + at + last_offset) );
+        return _mm_movemask_epi8( _mm_and_si128(
+            _mm_cmpeq_epi8( block_first, first ), _mm_cmpeq_epi8( block_last, last ) ) );
+    };
+
+    int i = 0;
+    for( ; (i + last_offset + 16) < len; i += 16 ) {
+        int result = find_string_sse2_candidates( buf, i, match( i ), substring );
+        if( result >= 0 ) {
+            return result;
+        }
+    }
+
+    int at = len - last_offset - 16;
+    return find_string_sse2_candidates(
+        buf, at, match( at ) & (0xFFFF << (i - at)), substring );
+}
+
+#if defined(SIMD_AVX2)
+
+// NOTE(alicia): strings shorter than one 32 byte block go to sse2 scan
+// before any ymm register is touched, sse2 scan is not vex encoded
+// and running it with dirty upper halves stalls every instruction.
+
+SIMD_TARGET_AVX2
+static int find_char_avx2( const char* buf, int len, char c ) {
+    if( len < 32 ) {
+        return find_char_sse2( buf, len, c );
+    }
+    __m256i needle = _mm256_set1_epi8( c );
+
+    int i = 0;
+    for( ; (i + 32) < len; i += 32 ) {
+        __m256i block = _mm256_loadu_si256( (const __m256i*)(buf + i) );
+
+        u32 mask = (u32)_mm256_movemask_epi8( _mm256_cmpeq_epi8( block, needle ) );
+        if( mask ) {
+            return i + __builtin_ctz( mask );
+        }
+    }
+
+    int     last  = len - 32;
+    __m256i block = _mm256_loadu_si256( (const __m256i*)(buf + last) );
+
+    u32 mask = (u32)_mm256_movemask_epi8( _mm256_cmpeq_epi8( block, needle ) ) &
+        (0xFFFFFFFFu << (i - last));
+    return mask ? last + __builtin_ctz( mask ) : -1;
+}
+
+SIMD_TARGET_AVX2
+static int find_set_avx2( const char* buf, int len, String set ) {
+    if( len < 32 ) {
+        return find_set_sse2( buf, len, set );
+    }
+
+    __m256i a     = _mm256_set1_epi8( simd_set_char( set, 0 ) );
+    __m256i b     = _mm256_set1_epi8( simd_set_char( set, 1 ) );
+    __m256i c     = _mm256_set1_epi8( simd_set_char( set, 2 ) );
+    __m256i d     = _mm256_set1_epi8( simd_set_char( set, 3 ) );
+    auto    match = [&]( int at ) SIMD_TARGET_AVX2 -> u32 {
+        __m256i block = _mm256_loadu_si256( (const __m256i*)(buf + at) );
+        return (u32)_mm256_movemask_epi8( _mm256_or_si256(
+            _mm256_or_si256( _mm256_cmpeq_epi8( block, a ), _mm256_cmpeq_epi8( block, b ) ),
+            _mm256_or_si256( _mm256_cmpeq_epi8( block, c ), _mm256_cmpeq_epi8( block, d ) ) ) );
+    };
+
+    int i = 0;
+    for( ; (i + 32) < len; i += 32 ) {
+        u32 mask = match( i );
+        if( mask ) {
+            return i + __builtin_ctz( mask );
+        }
+    }
+
+    int last = len - 32;
+    u32 mask = match( last ) & (0xFFFFFFFFu << (i - last));
+    return mask ? last + __builtin_ctz( mask ) : -1;
+}
+
+static int find_string_avx2_candidates( const char* buf, int at, u32 mask, String substring ) {
+    while( mask ) {
+        int offset = at + __builtin_ctz( mask );
+        if( memcmp( buf + offset + 1, substring.buf + 1, substring.len - 2 ) == 0 ) {
+            return offset;
+        }
+        mask &= mask - 1;
+    }
+    return -1;
+}
+SIMD_TARGET_AVX2
+static int find_string_avx2( const char* buf, int len, String substring ) {
+    int last_offset = substring.len - 1;
+    if( (len - last_offset) < 32 ) {
+        return find_string_sse2( buf, len, substring );
+    }
+
+    __m256i first = _mm256_set1_epi8( substring[0] );
+    __m256i last  = _mm256_set1_epi8( substring[last_offset] );
+    auto    match = [&]( int at ) SIMD_TARGET_AVX2 -> u32 {
+        __m256i block_first = _mm256_loadu_si256( (const __m256i*)(buf + at) );
+        __m256i block_last  = _mm256_loadu_si256( (const __m256i*)(buf + at + last_offset) );
+        return (u32)_mm256_movemask_epi8( _mm256_and_si256(
+            _mm256_cmpeq_epi8( block_first, first ), _mm256_cmpeq_epi8( block_last, last ) ) );
+    };
+
+    int i = 0;
+    for( ; (i + last_offset + 32) < len; i += 32 ) {
+        int result = find_string_avx2_candidates( buf, i, match( i ), substring );
+        if( result >= 0 ) {
+            return result;
+        }
+    }
+
+    int at = len - last_offset - 32;
+    return find_string_avx2_candidates(
+        buf, at, match( at ) & (0xFFFFFFFFu << (i - at)), substring );
+}
+
+#endif /* SIMD_AVX2 */
+
+#endif /* SIMD_X86 */
+
+static SimdLevel simd_level_detect() {
+#if defined(SIMD_X86)
+    #if defined(SIMD_AVX2)
+        __builtin_cpu_init();
+        if( __builtin_cpu_supports( "avx2" ) ) {
+            return SimdLevel::AVX2;
+        }
+    #endif
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel simd_level() {
+    static SimdLevel level = simd_level_detect();
+    return level;
+}
+
+bool simd_level_is_supported( SimdLevel level ) {
+    switch( level ) {
+        case SimdLevel::SCALAR: return true;
+        case SimdLevel::SSE2: {
+#if defined(SIMD_X86)
+            return true;
+#else
+            return false;
+#endif
+        }
+        case SimdLevel::AVX2: return simd_level() == SimdLevel::AVX2;
+
+        case SimdLevel::COUNT:
+            break;
+    }
     return false;
 }
-bool find_string( String string, String substring, int* opt_out_index ) {
-    for( int i = 0; i < string.len; ++i ) {
-        int remaining = string.len - i;
 
-        if( remaining < substring.len ) {
+String string_from_simd_level( SimdLevel level ) {
+    switch( level ) {
+        case SimdLevel::SCALAR : return "scalar";
+        case SimdLevel::SSE2   : return "sse2";
+        case SimdLevel::AVX2   : return "avx2";
+
+        case SimdLevel::COUNT:
             break;
+    }
+    return "unknown";
+}
+
+static bool find_result( int index, int* opt_out_index ) {
+    if( index < 0 ) {
+        return false;
+    }
+    if( opt_out_index ) {
+        *opt_out_index = index;
+    }
+    return true;
+}
+
+bool find_char_simd( SimdLevel level, String string, char c, int* opt_out_index ) {
+    int index = -1;
+    switch( level ) {
+#if defined(SIMD_X86)
+        case SimdLevel::SSE2: index = find_char_sse2( string.buf, string.len, c ); break;
+#if defined(SIMD_AVX2)
+        case SimdLevel::AVX2: index = find_char_avx2( string.buf, string.len, c ); break;
+#endif
+#endif
+        default: index = find_char_scalar( string.buf, 0, string.len, c ); break;
+    }
+    return find_result( index, opt_out_index );
+}
+// NOTE(alicia): vector scans are kept out of find functions so that
+// scalar head of a scan is inlined into callers and specialized
+// for sets and substrings that are known at call site.
+__attribute__((noinline))
+static int find_set_vector( SimdLevel level, const char* buf, int len, String set ) {
+    switch( level ) {
+#if defined(SIMD_X86)
+        case SimdLevel::SSE2: return find_set_sse2( buf, len, set );
+#if defined(SIMD_AVX2)
+        case SimdLevel::AVX2: return find_set_avx2( buf, len, set );
+#endif
+#endif
+        default: return find_set_scalar( buf, 0, len, set );
+    }
+}
+__attribute__((noinline))
+static int find_string_vector( SimdLevel level, const char* buf, int len, String substring ) {
+    switch( level ) {
+#if defined(SIMD_X86)
+        case SimdLevel::SSE2: return find_string_sse2( buf, len, substring );
+#if defined(SIMD_AVX2)
+        case SimdLevel::AVX2: return find_string_avx2( buf, len, substring );
+#endif
+#endif
+        default: return find_string_scalar( buf, 0, len, substring );
+    }
+}
+
+bool find_set_simd( SimdLevel level, String string, String set, int* opt_out_index ) {
+    if( !set.len || set.len > SIMD_SET_MAX ) {
+        level = SimdLevel::SCALAR;
+    }
+
+    int head = level == SimdLevel::SCALAR || string.len < SIMD_SCALAR_HEAD ?
+        string.len : SIMD_SCALAR_HEAD;
+
+    int index = find_set_scalar( string.buf, 0, head, set );
+    if( index < 0 && head < string.len ) {
+        index = find_set_vector( level, string.buf + head, string.len - head, set );
+        if( index >= 0 ) {
+            index += head;
         }
+    }
+    return find_result( index, opt_out_index );
+}
+bool find_string_simd(
+    SimdLevel level, String string, String substring, int* opt_out_index
+) {
+    // NOTE(alicia): vector loops compare first and last character separately.
+    if( substring.len < 2 ) {
+        level = SimdLevel::SCALAR;
+    }
 
-        if( memcmp( string + i, substring, substring.len ) == 0 ) {
-            if( opt_out_index ) {
-                *opt_out_index = i;
-            }
-            return true;
+    // NOTE(alicia): head is counted in offsets that a match can start at.
+    int head = level == SimdLevel::SCALAR || string.len < SIMD_SCALAR_HEAD ?
+        string.len : SIMD_SCALAR_HEAD;
+
+    int head_len = string.len;
+    if( head < string.len && (head + substring.len - 1) < string.len ) {
+        head_len = head + substring.len - 1;
+    }
+
+    int index = find_string_scalar( string.buf, 0, head_len, substring );
+    if( index < 0 && head_len < string.len ) {
+        index = find_string_vector( level, string.buf + head, string.len - head, substring );
+        if( index >= 0 ) {
+            index += head;
         }
     }
+    return find_result( index, opt_out_index );
+}
 
-    return false;
+bool find_char( String string, char c, int* opt_out_index ) {
+    return find_result( find_char_scalar( string.buf, 0, string.len, c ), opt_out_index );
+}
+bool find_set( String string, String set, int* opt_out_index ) {
+    return find_set_simd( simd_level(), string, set, opt_out_index );
+}
+bool find_string( String string, String substring, int* opt_out_index ) {
+    return find_string_simd( simd_level(), string, substring, opt_out_index );
 }
 
 Color parse_color( String string ) {
@@ -7,6 +7,13 @@
 #include "bog/prelude.h"
 #include "bog/entry.h"
 #include "bog/state.h"
+#include "bog/allocation.h"
+#include "bog/profile.h"
+#include "bog/loader.h"
+#include "bog/assets.h"
+#include "bog/scenes.h"
+#include "bog/fonts.h"
+#include "bog/replay.h"
 
 usize query_memory_requirement(void) {
     return sizeof(Memory);
@@ -25,6 +32,29 @@ bool on_init( void* memory ) {
 bool on_update( void* memory ) {
     auto* mem = (Memory*)memory;
 
+    PROFILE_ZONE( "frame" );
+
+    mem_frame_begin();
+    loader_update();
+
+#if defined(IS_DEBUG)
+    // NOTE(alicia): state is loaded at the end of a frame, that frame and
+    // the first frame of the new state are expected to allocate.
+    // frames after that should reuse memory.
+    static bool was_loading = true;
+
+    bool is_loading       = mem->state.common.is_first_frame;
+    u64  heap_allocations = mem_frame_heap_allocations();
+    if( heap_allocations && !is_loading && !was_loading ) {
+        TraceLog( LOG_INFO, "last frame made %llu heap allocation(s).", (unsigned long long)heap_allocations );
+    }
+    was_loading = is_loading;
+#endif
+
+    if( !replay_frame_begin( &mem->state ) ) {
+        return false;
+    }
+
     auto start_state = mem->state.type;
 
     state_update( &mem->state );
@@ -33,6 +63,12 @@ bool on_update( void* memory ) {
         state_set( &mem->state, start_state );
     }
 
+#if defined(BOG_PROFILE)
+    if( IsKeyPressed( KEY_F9 ) ) {
+        profile_export( TextFormat( "profile-%.0f.json", GetTime() ) );
+    }
+#endif
+
     if( mem->state.should_quit ) {
         return false;
     }
@@ -41,6 +77,15 @@ bool on_update( void* memory ) {
 
 void on_close( void* memory ) {
     (void)memory;
+
+    scenes_shutdown();
+    asset_shutdown();
+    loader_shutdown();
+    font_cache_shutdown();
+
+#if defined(BOG_PROFILE)
+    profile_export( "profile.json" );
+#endif
 }
 
 
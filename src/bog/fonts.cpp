@@ -0,0 +1,288 @@
+/**
+ * @file   fonts.cpp
+ * @brief  Font cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 30, 2025
+*/
+#include "bog/fonts.h"
+#include "bog/profile.h"
+#include "rlgl.h"
+#include <string.h>
+
+struct FontCacheSize {
+    Font font;
+
+    /* codepoint -> glyph index + 1 or 0 if empty, open addressing */
+    int* slots;
+};
+
+struct StateFonts {
+    /* 2x glyphs so that probes stay short */
+    static constexpr int SLOT_COUNT = FONT_CACHE_MAX_GLYPHS * 2;
+
+    unsigned char* file_data;
+    int            file_size;
+
+    int           size_count;
+    FontCacheSize sizes[FONT_CACHE_MAX_SIZES];
+
+    /* shared by every size, packed in rows from top left */
+    Texture atlas;
+    int     row_x, row_y, row_height;
+
+    bool is_atlas_full;
+};
+static StateFonts __FONTS;
+
+static u32 font_codepoint_hash( int codepoint ) {
+    u32 hash = (u32)codepoint * 2654435769u;
+    return hash ^ (hash >> 16);
+}
+
+static bool font_has( const FontCacheSize* size, int codepoint ) {
+    u32 mask = StateFonts::SLOT_COUNT - 1;
+    for( u32 i = font_codepoint_hash( codepoint ) & mask;; i = (i + 1) & mask ) {
+        int slot = size->slots[i];
+        if( !slot ) {
+            return false;
+        }
+        if( size->font.glyphs[slot - 1].value == codepoint ) {
+            return true;
+        }
+    }
+}
+
+static void font_insert( FontCacheSize* size, int index ) {
+    u32 mask = StateFonts::SLOT_COUNT - 1;
+    u32 at   = font_codepoint_hash( size->font.glyphs[index].value ) & mask;
+    while( size->slots[at] ) {
+        at = (at + 1) & mask;
+    }
+    size->slots[at] = index + 1;
+}
+
+// NOTE(alicia): glyph and its padding are uploaded together so that
+// quads, which include padding, never sample what was there before.
+static bool font_atlas_pack( const Image& image, Rectangle* out_rec ) {
+    auto* f = &__FONTS;
+
+    int width  = image.width  + (FONT_GLYPH_PADDING * 2);
+    int height = image.height + (FONT_GLYPH_PADDING * 2);
+
+    if( (f->row_x + width) > FONT_ATLAS_SIZE ) {
+        f->row_x       = 0;
+        f->row_y      += f->row_height;
+        f->row_height  = 0;
+    }
+    if( (f->row_y + height) > FONT_ATLAS_SIZE || width > FONT_ATLAS_SIZE ) {
+        if( !f->is_atlas_full ) {
+            TraceLog( LOG_WARNING, "font atlas is full, missing glyphs will be drawn as '?'." );
+            f->is_atlas_full = true;
+        }
+        return false;
+    }
+
+    Rectangle padded = { (float)f->row_x, (float)f->row_y, (float)width, (float)height };
+
+    f->row_x += width;
+    if( f->row_height < height ) {
+        f->row_height = height;
+    }
+
+    *out_rec = {
+        padded.x + FONT_GLYPH_PADDING, padded.y + FONT_GLYPH_PADDING,
+        (float)image.width, (float)image.height };
+
+    // NOTE(alicia): same as GenImageFontAtlas, white with coverage in alpha.
+    int count  = width * height * 2;
+    u8* pixels = mem_alloc<u8>( count );
+    if( image.data ) {
+        const u8* gray = (const u8*)image.data;
+        for( int y = 0; y < image.height; ++y ) {
+            u8* row = pixels + (((y + FONT_GLYPH_PADDING) * width) + FONT_GLYPH_PADDING) * 2;
+            for( int x = 0; x < image.width; ++x ) {
+                row[(x * 2) + 0] = 255;
+                row[(x * 2) + 1] = gray[(y * image.width) + x];
+            }
+        }
+    }
+
+    UpdateTextureRec( f->atlas, padded, pixels );
+
+    mem_free( pixels, count );
+    return true;
+}
+
+// NOTE(alicia): codepoints that file does not have are still added,
+// with whatever LoadFontData gives them, so that they are not asked for again.
+static void font_rasterize( FontCacheSize* size, int* codepoints, int count ) {
+    PROFILE_ZONE( "font_rasterize" );
+
+    auto* f    = &__FONTS;
+    auto* font = &size->font;
+
+    GlyphInfo* glyphs = LoadFontData(
+        f->file_data, f->file_size, font->baseSize, codepoints, count, FONT_DEFAULT );
+    if( !glyphs ) {
+        TraceLog( LOG_WARNING, "font: failed to rasterize %i glyph(s) at size %i.", count, font->baseSize );
+        return;
+    }
+
+    for( int i = 0; i < count; ++i ) {
+        GlyphInfo glyph = glyphs[i];
+
+        Rectangle rec = {};
+        if( glyph.image.width && glyph.image.height ) {
+            if( !font_atlas_pack( glyph.image, &rec ) ) {
+                break;
+            }
+        }
+
+        glyph.image = {};
+
+        int index = font->glyphCount++;
+        font->glyphs[index] = glyph;
+        font->recs[index]   = rec;
+
+        font_insert( size, index );
+    }
+
+    UnloadFontData( glyphs, count );
+}
+
+static FontCacheSize* font_cache_find( Font font ) {
+    auto* f = &__FONTS;
+    for( int i = 0; i < f->size_count; ++i ) {
+        if( f->sizes[i].font.glyphs == font.glyphs ) {
+            return f->sizes + i;
+        }
+    }
+    return nullptr;
+}
+
+bool font_cache_load( const char* path ) {
+    auto* f = &__FONTS;
+
+    f->file_data = LoadFileData( path, &f->file_size );
+    if( !f->file_data ) {
+        TraceLog( LOG_WARNING, "font: failed to load %s.", path );
+        return false;
+    }
+
+    return true;
+}
+
+Font font_cache_get( int size ) {
+    auto* f = &__FONTS;
+    if( !f->file_data ) {
+        return GetFontDefault();
+    }
+
+    for( int i = 0; i < f->size_count; ++i ) {
+        if( f->sizes[i].font.baseSize == size ) {
+            return f->sizes[i].font;
+        }
+    }
+
+    if( f->size_count >= FONT_CACHE_MAX_SIZES ) {
+        TraceLog( LOG_WARNING, "font: no room for size %i, using size %i.", size, f->sizes[0].font.baseSize );
+        return f->sizes[0].font;
+    }
+
+    if( !f->atlas.id ) {
+        f->atlas.id = rlLoadTexture(
+            nullptr, FONT_ATLAS_SIZE, FONT_ATLAS_SIZE, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA, 1 );
+        f->atlas.width   = FONT_ATLAS_SIZE;
+        f->atlas.height  = FONT_ATLAS_SIZE;
+        f->atlas.mipmaps = 1;
+        f->atlas.format  = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+    }
+
+    auto* entry = f->sizes + f->size_count++;
+
+    entry->font.baseSize     = size;
+    entry->font.glyphPadding = FONT_GLYPH_PADDING;
+    entry->font.texture      = f->atlas;
+    entry->font.glyphs       = mem_alloc<GlyphInfo>( FONT_CACHE_MAX_GLYPHS );
+    entry->font.recs         = mem_alloc<Rectangle>( FONT_CACHE_MAX_GLYPHS );
+    entry->slots             = mem_alloc<int>( StateFonts::SLOT_COUNT );
+
+    // NOTE(alicia): same glyphs LoadFontEx loads by default.
+    int ascii[95];
+    for( int i = 0; i < (int)ARRAY_LEN(ascii); ++i ) {
+        ascii[i] = ' ' + i;
+    }
+    font_rasterize( entry, ascii, ARRAY_LEN(ascii) );
+
+    return entry->font;
+}
+
+Font font_cache_require( Font font, String text ) {
+    FontCacheSize* size = font_cache_find( font );
+    if( !size ) {
+        return font;
+    }
+
+    List<int> missing = {};
+    missing.allocator = mem_frame();
+
+    int room = FONT_CACHE_MAX_GLYPHS - size->font.glyphCount;
+
+    for( int i = 0; i < text.len; ) {
+        // NOTE(alicia): ASCII is always there.
+        if( (u8)text[i] < 0x80 ) {
+            i++;
+            continue;
+        }
+
+        int codepoint_byte_count = 0;
+        int codepoint = GetCodepointNext( &text.buf[i], &codepoint_byte_count );
+        if( codepoint_byte_count < 1 ) {
+            codepoint_byte_count = 1;
+        }
+        i += codepoint_byte_count;
+
+        // NOTE(alicia): C1 control codes, invalid sequences decode as '?'.
+        if( codepoint < 0xA0 || font_has( size, codepoint ) ) {
+            continue;
+        }
+
+        bool is_duplicate = false;
+        for( int j = 0; j < missing.len; ++j ) {
+            if( missing[j] == codepoint ) {
+                is_duplicate = true;
+                break;
+            }
+        }
+        if( !is_duplicate && missing.len < room ) {
+            missing.push( codepoint );
+        }
+    }
+
+    if( missing.len && !__FONTS.is_atlas_full ) {
+        font_rasterize( size, missing.buf, missing.len );
+    }
+
+    missing.free();
+    return size->font;
+}
+
+void font_cache_shutdown() {
+    auto* f = &__FONTS;
+
+    for( int i = 0; i < f->size_count; ++i ) {
+        auto* size = f->sizes + i;
+        mem_free( size->font.glyphs, FONT_CACHE_MAX_GLYPHS );
+        mem_free( size->font.recs, FONT_CACHE_MAX_GLYPHS );
+        mem_free( size->slots, StateFonts::SLOT_COUNT );
+    }
+
+    if( f->atlas.id ) {
+        UnloadTexture( f->atlas );
+    }
+    if( f->file_data ) {
+        UnloadFileData( f->file_data );
+    }
+
+    *f = {};
+}
@@ -0,0 +1,363 @@
+/**
+ * @file   headless.cpp
+ * @brief  Run game state without a window.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 22, 2025
+*/
+#include "bog/headless.h"
+#include "bog/entry.h"
+#include "bog/state.h"
+#include "bog/scenes.h"
+#include "bog/profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+struct HeadlessOptions {
+    int   runs       = 1000;
+    u32   seed       = 1;
+    float dt         = 1.0f / 60.0f;
+    int   max_frames = 100000;
+    bool  typewriter = false;
+};
+
+/* nodes of one scene that any playthrough reached, by node index */
+struct HeadlessVisited {
+    int      scene_id;
+    List<u8> nodes;
+};
+
+// NOTE(alicia): headless runs load no textures, so backgrounds are checked
+// against what _game_prefetch would have required. windowed game prefetches
+// after a node's writes, so a write is checked against what the node
+// before it asked for. released backgrounds can stay in asset cache
+// until they are evicted, which is not counted here.
+struct HeadlessPrefetch {
+    int scene_id = -1, node_index = -1;
+    /* TEX_* bits required by last prefetch and by the one before it */
+    u32 wanted, resident;
+
+    int background_writes;
+    /* writes of a background that was not required yet */
+    int background_misses;
+    int max_resident_backgrounds;
+};
+
+// NOTE(alicia): first run also loads scenes, so only later runs are counted.
+// every run reloads game state, lists it frees are grown again once per run.
+struct HeadlessAllocations {
+    bool is_warm;
+
+    u64 frames;
+    /* frames of counted runs that made heap allocations */
+    u64 allocating_frames;
+    u64 allocations;
+};
+
+enum class HeadlessEnd {
+    FINISHED,
+    END_OF_SCENE,
+    DANGLING,
+    STUCK,
+
+    COUNT
+};
+
+static double headless_time() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>( now ).count();
+}
+
+// NOTE(alicia): xorshift32, only needs to be repeatable.
+static u32 headless_random( u32* state ) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static bool headless_parse_options( int count, char** args, HeadlessOptions* out ) {
+    for( int i = 0; i < count; ++i ) {
+        const char* arg   = args[i];
+        const char* value = (i + 1) < count ? args[i + 1] : nullptr;
+
+        if( strcmp( arg, "-typewriter" ) == 0 ) {
+            out->typewriter = true;
+            continue;
+        }
+
+        if( !value ) {
+            fprintf( stderr, "ERROR: headless option '%s' requires a value!\n", arg );
+            return false;
+        }
+
+        if( strcmp( arg, "-runs" ) == 0 ) {
+            out->runs = atoi( value );
+        } else if( strcmp( arg, "-seed" ) == 0 ) {
+            out->seed = (u32)strtoul( value, nullptr, 10 );
+        } else if( strcmp( arg, "-dt" ) == 0 ) {
+            out->dt = (float)atof( value );
+        } else if( strcmp( arg, "-max-frames" ) == 0 ) {
+            out->max_frames = atoi( value );
+        } else {
+            fprintf( stderr, "ERROR: unrecognized headless option '%s'!\n", arg );
+            return false;
+        }
+        i++;
+    }
+
+    if( out->runs < 1 || out->dt <= 0.0f || out->max_frames < 1 ) {
+        fprintf( stderr, "ERROR: headless options must be positive!\n" );
+        return false;
+    }
+    if( !out->seed ) {
+        out->seed = 1;
+    }
+    return true;
+}
+
+static List<u8>* headless_visited( List<HeadlessVisited>* visited, Scene* scene ) {
+    HeadlessVisited* result = nullptr;
+    for( int i = 0; i < visited->len; ++i ) {
+        if( visited->buf[i].scene_id == scene->id ) {
+            result = visited->buf + i;
+            break;
+        }
+    }
+    if( !result ) {
+        HeadlessVisited item = {};
+        item.scene_id = scene->id;
+
+        int index = visited->push( item );
+        result    = visited->buf + index;
+    }
+
+    while( result->nodes.len < scene->node_count() ) {
+        result->nodes.push( 0 );
+    }
+    return &result->nodes;
+}
+
+static void headless_prefetch( GameState* game, HeadlessPrefetch* prefetch ) {
+    auto* scene = game->scene;
+    if( prefetch->scene_id == scene->id && prefetch->node_index == scene->current ) {
+        return;
+    }
+    prefetch->scene_id   = scene->id;
+    prefetch->node_index = scene->current;
+    prefetch->resident   = prefetch->wanted;
+
+    u32 music = 0;
+    _game_prefetch_wanted( game, &prefetch->wanted, &music );
+
+    int backgrounds = 0;
+    for( int i = 0; i < BACKGROUND_COUNT; ++i ) {
+        backgrounds += (prefetch->wanted >> (TEX_BG1 + i)) & 1;
+    }
+    if( backgrounds > prefetch->max_resident_backgrounds ) {
+        prefetch->max_resident_backgrounds = backgrounds;
+    }
+}
+
+static HeadlessEnd headless_playthrough(
+    State* state, const HeadlessOptions* options, u32* rng,
+    List<HeadlessVisited>* visited, HeadlessPrefetch* prefetch,
+    HeadlessAllocations* allocations, int* out_frames
+) {
+    prefetch->scene_id   = -1;
+    prefetch->node_index = -1;
+    prefetch->wanted     = 0;
+    prefetch->resident   = 0;
+
+    int frames = 0;
+    for( ;; ) {
+        // NOTE(alicia): scene changes when a jump goes to another scene.
+        auto* scene = state->game.scene;
+        Node  node  = scene->get_current();
+        if( node.is_empty() ) {
+            *out_frames = frames;
+            return scene->current < 0 ? HeadlessEnd::END_OF_SCENE : HeadlessEnd::DANGLING;
+        }
+        if( frames >= options->max_frames ) {
+            *out_frames = frames;
+            return HeadlessEnd::STUCK;
+        }
+
+        headless_visited( visited, scene )->buf[node.index] = 1;
+
+        // NOTE(alicia): player that clicks every frame and
+        // picks a random option whenever there is a choice.
+        GameInput* input = &state->common.input;
+        *input = {};
+        input->dt          = options->dt;
+        input->advance     = true;
+        input->fast_text   = true;
+        input->reveal_text = !options->typewriter;
+        input->choice      = -1;
+        if( node.type == NodeType::FORK && node.fork->len ) {
+            input->choice = headless_random( rng ) % node.fork->len;
+        }
+
+        auto* game = &state->game;
+        int   bg   = game->kv.read( game->key.bg );
+
+        mem_frame_begin();
+        u64 heap_allocations = mem_heap_allocation_count();
+
+        state_update( state );
+        frames++;
+
+        if( allocations->is_warm ) {
+            u64 frame_allocations = mem_heap_allocation_count() - heap_allocations;
+
+            allocations->frames++;
+            allocations->allocating_frames += frame_allocations != 0;
+            allocations->allocations       += frame_allocations;
+        }
+
+        if( state->type != StateType::GAME ) {
+            *out_frames = frames;
+            return HeadlessEnd::FINISHED;
+        }
+
+        int new_bg = game->kv.read( game->key.bg );
+        if( new_bg != bg && new_bg >= 0 && new_bg < BACKGROUND_COUNT ) {
+            prefetch->background_writes++;
+            if( !(prefetch->resident & (1u << (TEX_BG1 + new_bg))) ) {
+                prefetch->background_misses++;
+            }
+        }
+
+        headless_prefetch( game, prefetch );
+    }
+}
+
+int headless_run( int count, char** args ) {
+    HeadlessOptions options = {};
+    if( !headless_parse_options( count, args, &options ) ) {
+        return 1;
+    }
+
+    SetTraceLogLevel( LOG_WARNING );
+
+    auto* memory = (Memory*)calloc( 1, query_memory_requirement() );
+    if( !memory ) {
+        fprintf( stderr, "ERROR: Failed to allocate memory of size %zu!\n", query_memory_requirement() );
+        return 1;
+    }
+
+    auto* state = &memory->state;
+    state->common.is_headless = true;
+
+    int      ends[(int)HeadlessEnd::COUNT] = {};
+    u64      total_frames = 0;
+    u32      rng          = options.seed;
+    List<HeadlessVisited> visited = {};
+    HeadlessPrefetch      prefetch = {};
+    HeadlessAllocations   allocations = {};
+
+    // NOTE(alicia): jumps within a scene are checked when it is loaded.
+    int dangling_jumps = scenes_validate();
+
+    double start = headless_time();
+
+    for( int run = 0; run < options.runs; ++run ) {
+        StateType old_type = run ? StateType::GAME : StateType::INVALID;
+
+        state->type = StateType::GAME;
+        state_set( state, old_type );
+
+        allocations.is_warm = run > 0;
+
+        int  frames = 0;
+        auto end    = headless_playthrough(
+            state, &options, &rng, &visited, &prefetch, &allocations, &frames );
+
+        ends[(int)end]++;
+        total_frames += frames;
+
+        if( end == HeadlessEnd::STUCK ) {
+            fprintf(
+                stderr, "ERROR: run %i: stuck on scene %i node %i after %i frames!\n",
+                run, state->game.scene->id, state->game.scene->current_id(), frames );
+        }
+    }
+
+    double elapsed = headless_time() - start;
+
+    int node_count = 0;
+    int unvisited  = 0;
+    for( int i = 0; i < visited.len; ++i ) {
+        const auto& nodes = visited[i].nodes;
+        node_count += nodes.len;
+        for( int j = 0; j < nodes.len; ++j ) {
+            unvisited += !nodes[j];
+        }
+    }
+
+    printf( "headless: %i runs, %llu frames in %.3fs\n",
+        options.runs, (unsigned long long)total_frames, elapsed );
+    printf( "  %12.0f runs/s  %12.0f frames/s\n",
+        options.runs / elapsed, total_frames / elapsed );
+    printf( "  finished %i  end of scene %i  dangling %i  stuck %i\n",
+        ends[(int)HeadlessEnd::FINISHED], ends[(int)HeadlessEnd::END_OF_SCENE],
+        ends[(int)HeadlessEnd::DANGLING], ends[(int)HeadlessEnd::STUCK] );
+    if( dangling_jumps ) {
+        printf( "  %i jump(s) to other scenes go to nodes that do not exist\n", dangling_jumps );
+    }
+    printf( "  visited %i/%i nodes in %i scene(s)\n", node_count - unvisited, node_count, visited.len );
+    printf( "  background writes %i, not required ahead of time %i, at most %i/%i required at once\n",
+        prefetch.background_writes, prefetch.background_misses,
+        prefetch.max_resident_backgrounds, BACKGROUND_COUNT );
+    if( options.runs > 1 ) {
+        printf( "  after first run: %.1f heap allocation(s) per run, in %llu/%llu frames\n",
+            (double)allocations.allocations / (options.runs - 1),
+            (unsigned long long)allocations.allocating_frames,
+            (unsigned long long)allocations.frames );
+    }
+
+    for( int i = 0; unvisited && i < visited.len; ++i ) {
+        const auto& nodes = visited[i].nodes;
+        Scene*      scene = scenes_acquire( visited[i].scene_id );
+
+        bool is_first = true;
+        for( int j = 0; scene && j < nodes.len && j < scene->node_count(); ++j ) {
+            if( nodes[j] ) {
+                continue;
+            }
+            if( is_first ) {
+                printf( "  scene %i never visited:", scene->id );
+                is_first = false;
+            }
+            printf( " %i", scene->ids[j] );
+        }
+        if( !is_first ) {
+            printf( "\n" );
+        }
+
+        if( scene ) {
+            scenes_release( scene );
+        }
+    }
+
+#if defined(BOG_PROFILE)
+    profile_export( "profile.json" );
+#endif
+
+    _game_unload( state );
+    scenes_shutdown();
+
+    for( int i = 0; i < visited.len; ++i ) {
+        visited[i].nodes.free();
+    }
+    visited.free();
+    ::free( memory );
+
+    bool failed =
+        dangling_jumps ||
+        ends[(int)HeadlessEnd::DANGLING] ||
+        ends[(int)HeadlessEnd::STUCK];
+    return failed ? 1 : 0;
+}
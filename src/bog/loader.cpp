@@ -0,0 +1,295 @@
+/**
+ * @file   loader.cpp
+ * @brief  Asset loading in the background.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 26, 2025
+*/
+#include "bog/loader.h"
+#include "bog/profile.h"
+#include <string.h>
+#include <atomic>
+
+#if !defined(PLATFORM_WEB)
+    #define LOADER_USE_THREADS
+    #include <mutex>
+    #include <thread>
+    #include <condition_variable>
+#endif
+
+enum class LoadJobType {
+    TEXTURE,
+    MUSIC,
+};
+
+enum {
+    LOAD_JOB_QUEUED,
+    LOAD_JOB_DECODED,
+    LOAD_JOB_FAILED,
+};
+
+struct LoadJob {
+    LoadJobType type;
+    char        path[LOADER_MAX_PATH];
+
+    Texture* out_texture;
+    int      filter;
+
+    Music*          out_music;
+    unsigned char** out_data;
+    int*            out_size;
+
+    /* written by worker before status is set */
+    Image          image;
+    unsigned char* data;
+    int            data_size;
+
+    std::atomic<int> status;
+};
+
+// NOTE(alicia): jobs are handed out in the order they were pushed.
+// once every job is uploaded the queue starts over from the first slot.
+struct StateLoader {
+    LoadJob jobs[LOADER_MAX_JOBS];
+
+    /* only changed by main thread */
+    int count;
+    int uploaded;
+
+    /* next job for a worker to decode */
+    int next;
+
+#if defined(LOADER_USE_THREADS)
+    std::mutex              lock;
+    std::condition_variable wake;
+    std::thread             workers[LOADER_THREAD_COUNT];
+
+    bool is_running;
+    bool is_quitting;
+#endif
+};
+static StateLoader __LOADER;
+
+static void loader_decode( LoadJob* job ) {
+    PROFILE_ZONE( "loader decode" );
+
+    int   size = 0;
+    auto* data = LoadFileData( job->path, &size );
+    if( !data ) {
+        job->status.store( LOAD_JOB_FAILED, std::memory_order_release );
+        return;
+    }
+
+    int status = LOAD_JOB_DECODED;
+    switch( job->type ) {
+        case LoadJobType::TEXTURE: {
+            job->image = LoadImageFromMemory( GetFileExtension( job->path ), data, size );
+            UnloadFileData( data );
+
+            if( !job->image.data ) {
+                status = LOAD_JOB_FAILED;
+            }
+        } break;
+        case LoadJobType::MUSIC: {
+            job->data      = data;
+            job->data_size = size;
+        } break;
+    }
+
+    job->status.store( status, std::memory_order_release );
+}
+
+static void loader_upload( LoadJob* job ) {
+    PROFILE_ZONE( "loader upload" );
+
+    switch( job->type ) {
+        case LoadJobType::TEXTURE: {
+            *job->out_texture = LoadTextureFromImage( job->image );
+            SetTextureFilter( *job->out_texture, job->filter );
+            UnloadImage( job->image );
+        } break;
+        case LoadJobType::MUSIC: {
+            *job->out_music = LoadMusicStreamFromMemory(
+                GetFileExtension( job->path ), job->data, job->data_size );
+            *job->out_data  = job->data;
+            *job->out_size  = job->data_size;
+        } break;
+    }
+}
+
+#if defined(LOADER_USE_THREADS)
+
+static void loader_worker() {
+    auto* l = &__LOADER;
+
+    for( ;; ) {
+        LoadJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock( l->lock );
+            l->wake.wait( lock, [l] { return l->is_quitting || l->next < l->count; } );
+
+            if( l->next >= l->count ) {
+                return;
+            }
+            job = l->jobs + l->next++;
+        }
+
+        loader_decode( job );
+    }
+}
+
+#endif
+
+static LoadJob* loader_push( LoadJobType type, const char* path ) {
+    auto* l = &__LOADER;
+
+    Assert( l->count < LOADER_MAX_JOBS, "loader queue is full!" );
+    Assert( strlen( path ) < LOADER_MAX_PATH, "%s: loader path is too long!", path );
+
+    auto* job = l->jobs + l->count;
+
+    job->type = type;
+    strcpy( job->path, path );
+
+    job->image     = {};
+    job->data      = nullptr;
+    job->data_size = 0;
+    job->status.store( LOAD_JOB_QUEUED, std::memory_order_relaxed );
+
+    return job;
+}
+
+static void loader_submit() {
+    auto* l = &__LOADER;
+
+#if defined(LOADER_USE_THREADS)
+    {
+        std::lock_guard<std::mutex> lock( l->lock );
+        l->count++;
+    }
+
+    if( !l->is_running ) {
+        l->is_running  = true;
+        l->is_quitting = false;
+        for( auto& worker : l->workers ) {
+            worker = std::thread( loader_worker );
+        }
+    }
+
+    l->wake.notify_one();
+#else
+    l->count++;
+#endif
+}
+
+void loader_push_texture( const char* path, int filter, Texture* out ) {
+    auto* job = loader_push( LoadJobType::TEXTURE, path );
+
+    *out = {};
+    job->out_texture = out;
+    job->filter      = filter;
+
+    loader_submit();
+}
+void loader_push_music( const char* path, Music* out, unsigned char** out_data, int* out_size ) {
+    auto* job = loader_push( LoadJobType::MUSIC, path );
+
+    *out      = {};
+    *out_data = nullptr;
+    *out_size = 0;
+    job->out_music = out;
+    job->out_data  = out_data;
+    job->out_size  = out_size;
+
+    loader_submit();
+}
+
+bool loader_is_pending( const void* out ) {
+    auto* l = &__LOADER;
+    for( int i = l->uploaded; i < l->count; ++i ) {
+        const auto& job = l->jobs[i];
+
+        const void* job_out = nullptr;
+        switch( job.type ) {
+            case LoadJobType::TEXTURE: job_out = job.out_texture; break;
+            case LoadJobType::MUSIC:   job_out = job.out_music;   break;
+        }
+        if( job_out == out ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void loader_update() {
+    auto* l = &__LOADER;
+
+#if !defined(LOADER_USE_THREADS)
+    if( l->next < l->count ) {
+        loader_decode( l->jobs + l->next++ );
+    }
+#endif
+
+    // NOTE(alicia): uploads go in push order so that
+    // whatever was pushed first shows up first.
+    while( l->uploaded < l->count ) {
+        auto* job = l->jobs + l->uploaded;
+
+        int status = job->status.load( std::memory_order_acquire );
+        if( status == LOAD_JOB_QUEUED ) {
+            break;
+        }
+
+        if( status == LOAD_JOB_DECODED ) {
+            loader_upload( job );
+        } else {
+            TraceLog( LOG_WARNING, "%s: failed to load asset!", job->path );
+        }
+        l->uploaded++;
+    }
+
+    if( l->count && l->uploaded == l->count ) {
+#if defined(LOADER_USE_THREADS)
+        std::lock_guard<std::mutex> lock( l->lock );
+#endif
+        l->count = l->uploaded = l->next = 0;
+    }
+}
+void loader_wait() {
+    PROFILE_ZONE( "loader wait" );
+
+    while( __LOADER.count ) {
+        loader_update();
+
+#if defined(LOADER_USE_THREADS)
+        if( __LOADER.count ) {
+            std::this_thread::yield();
+        }
+#endif
+    }
+}
+LoaderProgress loader_progress() {
+    return { __LOADER.uploaded, __LOADER.count };
+}
+
+void loader_shutdown() {
+    loader_wait();
+
+#if defined(LOADER_USE_THREADS)
+    auto* l = &__LOADER;
+    if( !l->is_running ) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( l->lock );
+        l->is_quitting = true;
+    }
+    l->wake.notify_all();
+
+    for( auto& worker : l->workers ) {
+        worker.join();
+    }
+    l->is_running = false;
+#endif
+}
+
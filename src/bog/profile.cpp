@@ -0,0 +1,163 @@
+/**
+ * @file   profile.cpp
+ * @brief  Frame profiler.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 23, 2025
+*/
+#include "bog/profile.h"
+
+#if defined(BOG_PROFILE)
+
+#include "bog/collections.h"
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+static_assert(
+    (PROFILE_SAMPLE_COUNT & (PROFILE_SAMPLE_COUNT - 1)) == 0,
+    "profile sample count must be a power of two!" );
+
+struct ProfileSample {
+    /* index + 1 of sample written to this slot, 0 while it is being written */
+    std::atomic<u32> sequence;
+
+    const char* name;
+    u64         start;
+    u64         end;
+    u32         thread;
+};
+
+// NOTE(alicia): ring buffer of finished zones.
+// writers claim a slot with one atomic add and never wait,
+// oldest samples are overwritten once it wraps around.
+struct StateProfile {
+    std::atomic<u32> head;
+    std::atomic<u32> thread_count;
+
+    ProfileSample samples[PROFILE_SAMPLE_COUNT];
+};
+static StateProfile __PROFILE;
+
+struct StateProfileThread {
+    u32 id;
+    int depth;
+
+    const char* names[PROFILE_MAX_DEPTH];
+    u64         starts[PROFILE_MAX_DEPTH];
+};
+static thread_local StateProfileThread __PROFILE_THREAD;
+
+static u64 profile_now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( now ).count();
+}
+
+void profile_begin( const char* name ) {
+    auto* t = &__PROFILE_THREAD;
+    if( !t->id ) {
+        t->id = __PROFILE.thread_count.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    }
+
+    Assert( t->depth < PROFILE_MAX_DEPTH, "profile zones nested too deep!" );
+
+    t->names[t->depth]  = name;
+    t->starts[t->depth] = profile_now();
+    t->depth++;
+}
+void profile_end() {
+    u64 end = profile_now();
+
+    auto* t = &__PROFILE_THREAD;
+    Assert( t->depth > 0, "profile_end without profile_begin!" );
+    t->depth--;
+
+    u32 index = __PROFILE.head.fetch_add( 1, std::memory_order_relaxed );
+
+    auto* sample = __PROFILE.samples + (index & (PROFILE_SAMPLE_COUNT - 1));
+    sample->sequence.store( 0, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    sample->name   = t->names[t->depth];
+    sample->start  = t->starts[t->depth];
+    sample->end    = end;
+    sample->thread = t->id;
+
+    sample->sequence.store( index + 1, std::memory_order_release );
+}
+
+bool profile_export( const char* path ) {
+    u32 head  = __PROFILE.head.load( std::memory_order_acquire );
+    u32 count = head < PROFILE_SAMPLE_COUNT ? head : PROFILE_SAMPLE_COUNT;
+
+    List<ProfileSample*> samples = {};
+    samples.reserve( count );
+
+    u64 origin = ~(u64)0;
+    List<char> out = {};
+
+    auto append = [&out]( const char* text ) {
+        out.append( strlen( text ), text );
+    };
+
+    append( "{\"traceEvents\":[\n" );
+
+    // NOTE(alicia): first pass finds earliest sample so that
+    // timestamps start at zero, slots still being written are skipped.
+    for( u32 i = head - count; i != head; ++i ) {
+        auto* sample = __PROFILE.samples + (i & (PROFILE_SAMPLE_COUNT - 1));
+        if( sample->sequence.load( std::memory_order_acquire ) != i + 1 ) {
+            continue;
+        }
+        samples.push( sample );
+        if( sample->start < origin ) {
+            origin = sample->start;
+        }
+    }
+
+    bool first = true;
+    for( int i = 0; i < samples.len; ++i ) {
+        auto* sample   = samples[i];
+        u32   sequence = sample->sequence.load( std::memory_order_acquire );
+
+        const char* name   = sample->name;
+        u64         start  = sample->start;
+        u64         end    = sample->end;
+        u32         thread = sample->thread;
+
+        // NOTE(alicia): sample was overwritten while it was being read.
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( !sequence || sample->sequence.load( std::memory_order_relaxed ) != sequence ) {
+            continue;
+        }
+        if( start < origin ) {
+            continue;
+        }
+
+        char line[256];
+        snprintf(
+            line, sizeof(line),
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+            first ? "" : ",\n",
+            name,
+            (start - origin) / 1000.0,
+            (end - start) / 1000.0,
+            thread );
+        append( line );
+
+        first = false;
+    }
+
+    append( "\n]}\n" );
+
+    bool result = SaveFileData( path, out.buf, out.len );
+    if( result ) {
+        TraceLog( LOG_INFO, "wrote %i profile samples to %s", samples.len, path );
+    }
+
+    samples.free();
+    out.free();
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ * @file   replay.cpp
+ * @brief  Frame input, recording and playback.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 31, 2025
+*/
+#include "bog/replay.h"
+#include "bog/state.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC   (0x52474F42) /* "BOGR" */
+#define REPLAY_VERSION (1)
+
+/* mouse buttons kept in a frame, left, right and middle */
+#define REPLAY_BUTTON_COUNT (3)
+
+struct ReplayHeader {
+    u32 magic;
+    u32 version;
+    u32 frame_count;
+    u16 screen_width;
+    u16 screen_height;
+};
+
+struct ReplayFrame {
+    float dt;
+    float mouse_x, mouse_y;
+    u8    down;
+    u8    pressed;
+    /* game state before frame */
+    u16   checksum;
+};
+static_assert( sizeof(ReplayFrame) == 16, "replay frames are written as is!" );
+
+struct StateReplay {
+    ReplayMode mode;
+    char       path[256];
+
+    FrameInput input;
+
+    List<ReplayFrame> frames;
+    int               next;
+    int               screen_width, screen_height;
+
+    /* playback, seconds between frame starts */
+    List<float> frame_times;
+    double      last_frame_start;
+
+    int diverged_count;
+    int first_diverged;
+};
+static StateReplay __REPLAY;
+
+static u16 replay_checksum( const State* state ) {
+    u32 hash = 2166136261u;
+    auto mix = [&hash]( int value ) {
+        hash ^= (u32)value;
+        hash *= 16777619u;
+    };
+
+    mix( (int)state->type );
+    switch( state->type ) {
+        case StateType::MAIN_MENU: {
+            mix( state->menu.is_settings_open );
+            mix( state->menu.is_credits_open );
+        } break;
+        case StateType::GAME: {
+            auto* s = &state->game;
+            mix( s->scene ? s->scene->id : -1 );
+            mix( s->scene ? s->scene->current : -1 );
+            mix( s->display_text.len );
+            mix( s->is_paused );
+            mix( s->is_settings_open );
+        } break;
+        case StateType::INVALID:
+        case StateType::INTRO:
+            break;
+    }
+
+    return (u16)(hash ^ (hash >> 16));
+}
+
+static FrameInput replay_sample() {
+    FrameInput result = {};
+
+    result.dt    = GetFrameTime();
+    result.mouse = GetMousePosition();
+    for( int button = 0; button < REPLAY_BUTTON_COUNT; ++button ) {
+        if( IsMouseButtonDown( button ) ) {
+            result.down |= 1 << button;
+        }
+        if( IsMouseButtonPressed( button ) ) {
+            result.pressed |= 1 << button;
+        }
+    }
+
+    return result;
+}
+
+bool replay_record( const char* path ) {
+    auto* r = &__REPLAY;
+
+    if( strlen( path ) >= sizeof(r->path) ) {
+        fprintf( stderr, "ERROR: replay path '%s' is too long!\n", path );
+        return false;
+    }
+
+    *r = {};
+    r->mode = ReplayMode::RECORD;
+    strcpy( r->path, path );
+    return true;
+}
+
+bool replay_playback( const char* path ) {
+    auto* r = &__REPLAY;
+
+    int   size = 0;
+    auto* data = LoadFileData( path, &size );
+    if( !data ) {
+        fprintf( stderr, "ERROR: failed to read replay '%s'!\n", path );
+        return false;
+    }
+
+    auto* header = (ReplayHeader*)data;
+    auto* frames = (ReplayFrame*)(header + 1);
+
+    bool is_valid =
+        size >= (int)sizeof(ReplayHeader) &&
+        header->magic   == REPLAY_MAGIC   &&
+        header->version == REPLAY_VERSION &&
+        size == (int)(sizeof(ReplayHeader) + sizeof(ReplayFrame) * header->frame_count);
+
+    if( is_valid ) {
+        *r = {};
+        r->mode          = ReplayMode::PLAYBACK;
+        r->screen_width  = header->screen_width;
+        r->screen_height = header->screen_height;
+        r->frames.append( header->frame_count, frames );
+        r->frame_times.reserve( header->frame_count );
+    } else {
+        fprintf( stderr, "ERROR: '%s' is not a replay or was recorded by another version!\n", path );
+    }
+
+    UnloadFileData( data );
+    return is_valid;
+}
+
+ReplayMode replay_mode() {
+    return __REPLAY.mode;
+}
+
+bool replay_frame_begin( const State* state ) {
+    auto* r = &__REPLAY;
+
+    switch( r->mode ) {
+        case ReplayMode::NONE: {
+            r->input = replay_sample();
+        } break;
+        case ReplayMode::RECORD: {
+            r->input = replay_sample();
+
+            if( !r->frames.len ) {
+                r->screen_width  = GetScreenWidth();
+                r->screen_height = GetScreenHeight();
+            }
+
+            ReplayFrame frame = {};
+            frame.dt       = r->input.dt;
+            frame.mouse_x  = r->input.mouse.x;
+            frame.mouse_y  = r->input.mouse.y;
+            frame.down     = r->input.down;
+            frame.pressed  = r->input.pressed;
+            frame.checksum = replay_checksum( state );
+            r->frames.push( frame );
+        } break;
+        case ReplayMode::PLAYBACK: {
+            double now = GetTime();
+            if( r->next ) {
+                r->frame_times.push( (float)(now - r->last_frame_start) );
+            } else if(
+                r->screen_width  != GetScreenWidth() ||
+                r->screen_height != GetScreenHeight()
+            ) {
+                TraceLog(
+                    LOG_WARNING, "replay was recorded at %ix%i, mouse will not line up.",
+                    r->screen_width, r->screen_height );
+            }
+            r->last_frame_start = now;
+
+            if( r->next >= r->frames.len ) {
+                return false;
+            }
+
+            const ReplayFrame& frame = r->frames[r->next];
+            if( frame.checksum != replay_checksum( state ) ) {
+                if( !r->diverged_count ) {
+                    r->first_diverged = r->next;
+                }
+                r->diverged_count++;
+            }
+
+            r->input = {};
+            r->input.dt      = frame.dt;
+            r->input.mouse   = { frame.mouse_x, frame.mouse_y };
+            r->input.down    = frame.down;
+            r->input.pressed = frame.pressed;
+
+            r->next++;
+        } break;
+    }
+
+    return true;
+}
+
+static float replay_percentile( const List<float>& sorted, float percent ) {
+    int index = (int)((sorted.len - 1) * percent + 0.5f);
+    return sorted[index];
+}
+
+// NOTE(alicia): frame times, buckets are in milliseconds and 16.7 and 33.3
+// are the budgets of 60 and 30 frames per second.
+static void replay_report() {
+    auto* r = &__REPLAY;
+
+    printf(
+        "replay: %i of %i frame(s) played, %i frame(s) played out differently",
+        r->next, r->frames.len, r->diverged_count );
+    if( r->diverged_count ) {
+        printf( ", first at frame %i", r->first_diverged );
+    }
+    printf( "\n" );
+
+    if( !r->frame_times.len ) {
+        return;
+    }
+
+    List<float> sorted = {};
+    sorted.append( r->frame_times.len, r->frame_times.buf );
+    qsort( sorted.buf, sorted.len, sizeof(float), []( const void* a, const void* b ) {
+        float fa = *(const float*)a, fb = *(const float*)b;
+        return (fa > fb) - (fa < fb);
+    } );
+
+    double total = 0.0;
+    for( int i = 0; i < sorted.len; ++i ) {
+        total += sorted[i];
+    }
+
+    printf(
+        "  frame time  min %.3fms  p50 %.3fms  p90 %.3fms  p99 %.3fms  max %.3fms  avg %.3fms\n",
+        sorted[0] * 1000.0f,
+        replay_percentile( sorted, 0.50f ) * 1000.0f,
+        replay_percentile( sorted, 0.90f ) * 1000.0f,
+        replay_percentile( sorted, 0.99f ) * 1000.0f,
+        sorted[sorted.len - 1] * 1000.0f,
+        (total / sorted.len) * 1000.0 );
+
+    _readonly float BUCKETS[] = { 0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 16.7f, 33.3f, 50.0f, 100.0f };
+    _readonly int   BAR_WIDTH = 40;
+
+    int counts[ARRAY_LEN(BUCKETS) + 1] = {};
+    for( int i = 0; i < sorted.len; ++i ) {
+        float ms = sorted[i] * 1000.0f;
+
+        size_t bucket = 0;
+        while( bucket < ARRAY_LEN(BUCKETS) && ms >= BUCKETS[bucket] ) {
+            bucket++;
+        }
+        counts[bucket]++;
+    }
+
+    int max_count = 1;
+    for( int count : counts ) {
+        if( count > max_count ) {
+            max_count = count;
+        }
+    }
+
+    for( size_t i = 0; i < ARRAY_LEN(counts); ++i ) {
+        char label[32];
+        if( i < ARRAY_LEN(BUCKETS) ) {
+            snprintf( label, sizeof(label), "< %.1fms", BUCKETS[i] );
+        } else {
+            snprintf( label, sizeof(label), ">= %.1fms", BUCKETS[i - 1] );
+        }
+
+        int  bar_len = (counts[i] * BAR_WIDTH + max_count - 1) / max_count;
+        char bar[BAR_WIDTH + 1];
+        memset( bar, '#', bar_len );
+        bar[bar_len] = 0;
+
+        printf(
+            "  %-10s %8i %6.2f%%  %s\n",
+            label, counts[i], (counts[i] * 100.0) / sorted.len, bar );
+    }
+
+    sorted.free();
+}
+
+int replay_finish() {
+    auto* r = &__REPLAY;
+
+    int result = 0;
+    switch( r->mode ) {
+        case ReplayMode::NONE: break;
+        case ReplayMode::RECORD: {
+            ReplayHeader header = {};
+            header.magic         = REPLAY_MAGIC;
+            header.version       = REPLAY_VERSION;
+            header.frame_count   = r->frames.len;
+            header.screen_width  = r->screen_width;
+            header.screen_height = r->screen_height;
+
+            List<char> out = {};
+            out.append( sizeof(header), (const char*)&header );
+            out.append( sizeof(ReplayFrame) * r->frames.len, (const char*)r->frames.buf );
+
+            if( SaveFileData( r->path, out.buf, out.len ) ) {
+                printf( "replay: %i frame(s) -> %s\n", r->frames.len, r->path );
+            } else {
+                fprintf( stderr, "ERROR: failed to write replay '%s'!\n", r->path );
+                result = 1;
+            }
+            out.free();
+        } break;
+        case ReplayMode::PLAYBACK: {
+            replay_report();
+            if( r->diverged_count || r->next < r->frames.len ) {
+                result = 1;
+            }
+        } break;
+    }
+
+    r->frames.free();
+    r->frame_times.free();
+    r->mode = ReplayMode::NONE;
+
+    return result;
+}
+
+const FrameInput& frame_input() {
+    return __REPLAY.input;
+}
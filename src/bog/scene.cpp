@@ -5,429 +5,1704 @@
  * @date   August 13, 2025
 */
 #include "bog/scene.h"
-#include "json.h"
+#include "bog/profile.h"
+#include "bog/animation.h"
+#include <stdio.h>
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define SCENE_USE_MMAP
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#define SCENE_COMPILED_MAGIC   (0x53474F42) /* "BOGS" */
+#define SCENE_COMPILED_VERSION (7)
+#define SCENE_COMPILED_ALIGN   (16)
+
+struct SceneSection {
+    u32 offset; /* byte offset from start of file */
+    u32 len;    /* number of items */
+};
+
+// NOTE(alicia): everything after the header is the scene's lists, written as is.
+// payload/fork option sizes are stored so that files from an incompatible build are rejected.
+// story nodes store AnimationCap values, so files from a build
+// with a different animation table are rejected too.
+struct SceneCompiledHeader {
+    u32 magic;
+    u32 version;
+    u32 story_size;
+    u32 control_size;
+    u32 fork_option_size;
+    u32 animation_count;
+    u32 animation_names_hash;
+
+    i32          id;
+    StringOffset title;
+
+    SceneSection types;
+    SceneSection ids;
+    SceneSection payloads;
+    SceneSection stories;
+    SceneSection controls;
+    SceneSection writes;
+    SceneSection forks;
+    SceneSection fades;
+    SceneSection string;
+    SceneSection storage;
+    SceneSection lookup;
+    SceneSection keys;
+};
+
+static void scene_load_json( const char* path, Scene* sc );
+static bool scene_load_compiled( const char* path, Scene* sc );
+
+// compiled sibling of json scene at path, null if missing or out of date.
+static const char* scene_compiled_sibling( const char* path ) {
+    const char* compiled = TextFormat(
+        "%s/%s" SCENE_COMPILED_EXT, GetDirectoryPath( path ), GetFileNameWithoutExt( path ) );
+
+    if( FileExists( compiled ) && GetFileModTime( compiled ) >= GetFileModTime( path ) ) {
+        return compiled;
+    }
+    return nullptr;
+}
 
-json_value_s* search_field(
-    json_object_s* obj, const char* key, json_type_e type = json_type_null
-) {
-    auto* at = obj->start;
-    for( size_t i = 0; i < obj->length; ++i ) {
-        if( strcmp( at->name->string, key ) == 0 ) {
-            if( type == json_type_null ) {
-                return at->value;
-            } else {
-                switch( type ) {
-                    case json_type_true:
-                    case json_type_false: {
-                        if(
-                            at->value->type == json_type_true ||
-                            at->value->type == json_type_false
-                        ) {
-                            return at->value;
+void scene_load( const char* path, Scene* sc ) {
+    PROFILE_ZONE( "scene_load" );
+
+    if( IsFileExtension( path, SCENE_COMPILED_EXT ) ) {
+        Assert( scene_load_compiled( path, sc ), "%s: failed to load compiled scene!", path );
+        return;
+    }
+
+    const char* compiled = scene_compiled_sibling( path );
+    if( compiled ) {
+        if( scene_load_compiled( compiled, sc ) ) {
+            return;
+        }
+        TraceLog( LOG_WARNING, "%s: compiled scene is invalid, loading %s instead.", compiled, path );
+    }
+
+    scene_load_json( path, sc );
+}
+
+// NOTE(alicia): json reader ------------------------------------------------------------
+// single pass reader, values are read as they are reached and written
+// directly into the scene. strings are slices into source until pushed.
+
+struct JsonReader {
+    const char* path;
+    const char* start;
+    const char* at;
+    const char* end;
+};
+
+enum class JsonType {
+    NONE,
+    STRING,
+    NUMBER,
+    OBJECT,
+    ARRAY,
+    TRUE,
+    FALSE,
+    NULL_,
+};
+
+static void json_location( JsonReader* r, const char* position, int* out_line, int* out_column ) {
+    int line = 1, column = 1;
+    for( const char* at = r->start; at < position; ++at ) {
+        if( *at == '\n' ) {
+            line++;
+            column = 1;
+        } else {
+            column++;
+        }
+    }
+    *out_line   = line;
+    *out_column = column;
+}
+
+[[noreturn]]
+static void json_error( JsonReader* r, const char* message ) {
+    int line = 0, column = 0;
+    json_location( r, r->at, &line, &column );
+    Panic( "%s:%i:%i: failed to parse json! %s", r->path, line, column, message );
+}
+
+static void json_skip_whitespace( JsonReader* r ) {
+    while( r->at < r->end ) {
+        switch( *r->at ) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n': {
+                r->at++;
+            } continue;
+            case '/': {
+                if( (r->at + 1) >= r->end ) {
+                    json_error( r, "unexpected '/'" );
+                }
+                if( r->at[1] == '/' ) {
+                    r->at += 2;
+                    while( r->at < r->end && *r->at != '\n' ) {
+                        r->at++;
+                    }
+                } else if( r->at[1] == '*' ) {
+                    r->at += 2;
+                    while( true ) {
+                        if( (r->at + 1) >= r->end ) {
+                            json_error( r, "unterminated comment" );
                         }
-                    } break;
-                    case json_type_string:
-                    case json_type_number:
-                    case json_type_object:
-                    case json_type_array:
-                    case json_type_null: {
-                        if( at->value->type == type ) {
-                            return at->value;
+                        if( r->at[0] == '*' && r->at[1] == '/' ) {
+                            r->at += 2;
+                            break;
                         }
-                    } break;
+                        r->at++;
+                    }
+                } else {
+                    json_error( r, "unexpected '/'" );
                 }
-            }
+            } continue;
         }
-        at = at->next;
+        break;
     }
+}
 
-    return nullptr;
+static JsonType json_peek( JsonReader* r ) {
+    json_skip_whitespace( r );
+    if( r->at >= r->end ) {
+        return JsonType::NONE;
+    }
+
+    switch( *r->at ) {
+        case '"': return JsonType::STRING;
+        case '{': return JsonType::OBJECT;
+        case '[': return JsonType::ARRAY;
+        case 't': return JsonType::TRUE;
+        case 'f': return JsonType::FALSE;
+        case 'n': return JsonType::NULL_;
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return JsonType::NUMBER;
+        default: break;
+    }
+    return JsonType::NONE;
 }
-String string_from_json( json_string_s* string ) {
-    return { (int)string->string_size, string->string };
+
+static void json_expect( JsonReader* r, char c ) {
+    json_skip_whitespace( r );
+    if( r->at >= r->end || *r->at != c ) {
+        json_error( r, TextFormat( "expected '%c'", c ) );
+    }
+    r->at++;
 }
 
-void scene_load( const char* path, Scene* sc ) {
-    Slice<char> src; {
-        src.buf = LoadFileText( path );
-        src.len = strlen( src.buf );
+static bool json_accept( JsonReader* r, char c ) {
+    json_skip_whitespace( r );
+    if( r->at < r->end && *r->at == c ) {
+        r->at++;
+        return true;
     }
+    return false;
+}
 
-    json_parse_result_s parse_result = {};
-    auto* json = json_parse_ex( src.buf, src.len, json_parse_flags_allow_c_style_comments, 0, 0, &parse_result );
-    Assert( json, "%s:%zu:%zu: failed to parse json!", path, parse_result.error_line_no, parse_result.error_row_no );
+/* returns contents of string without quotes, escapes are left as is */
+static String json_string( JsonReader* r ) {
+    json_expect( r, '"' );
+
+    const char* start = r->at;
+    while( r->at < r->end ) {
+        switch( *r->at ) {
+            case '"': {
+                String result = { (int)(r->at - start), start };
+                r->at++;
+                return result;
+            } break;
+            case '\\': {
+                r->at += 2;
+            } continue;
+            default: break;
+        }
+        r->at++;
+    }
 
-    auto* root = json_value_as_object( json );
+    json_error( r, "unterminated string" );
+}
 
-    auto* id       = search_field( root, "id", json_type_number );
-    auto* title    = search_field( root, "title", json_type_string );
-    auto* tree_ptr = search_field( root, "tree", json_type_array );
+static String json_number( JsonReader* r ) {
+    json_skip_whitespace( r );
 
-    Assert( id && tree_ptr, "%s: scene requires 'id' and 'tree' fields!", path );
+    const char* start = r->at;
+    while( r->at < r->end ) {
+        char c = *r->at;
+        if( !( (c >= '0' && c <= '9') ||
+            c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'
+        ) ) {
+            break;
+        }
+        r->at++;
+    }
 
-    auto* tree = json_value_as_array( tree_ptr );
+    if( r->at == start ) {
+        json_error( r, "expected number" );
+    }
 
-    sc->reset();
+    return { (int)(r->at - start), start };
+}
+
+static void json_literal( JsonReader* r, String literal ) {
+    json_skip_whitespace( r );
+    if(
+        (r->end - r->at) < literal.len ||
+        memcmp( r->at, literal.buf, literal.len ) != 0
+    ) {
+        json_error( r, TextFormat( "expected '%s'", literal.buf ) );
+    }
+    r->at += literal.len;
+}
 
-    sc->id = atoi( json_value_as_number( id )->number );
+/* index counts members read so far, start at 0 */
+static bool json_object_next( JsonReader* r, int* index, String* out_key ) {
+    if( *index == 0 ) {
+        json_expect( r, '{' );
+    }
 
-    if( title ) {
-        sc->title = string_offset_push(
-            &sc->string, string_from_json( json_value_as_string( title ) ) );
+    if( json_accept( r, '}' ) ) {
+        return false;
     }
+    if( *index ) {
+        json_expect( r, ',' );
+    }
+
+    *out_key = json_string( r );
+    json_expect( r, ':' );
+
+    (*index)++;
+    return true;
+}
 
-    sc->nodes.reserve( tree->length );
+/* index counts values read so far, start at 0 */
+static bool json_array_next( JsonReader* r, int* index ) {
+    if( *index == 0 ) {
+        json_expect( r, '[' );
+    }
 
-    auto* at = tree->start;
-    for( size_t i = 0; i < tree->length; ++i ) {
-        Node value = {};
+    if( json_accept( r, ']' ) ) {
+        return false;
+    }
+    if( *index ) {
+        json_expect( r, ',' );
+    }
 
-        auto* node = json_value_as_object( at->value );
-        Assert( node, "%s: tree nodes must be objects!", path );
+    (*index)++;
+    return true;
+}
 
-        auto* ptr_type = search_field( node, "type", json_type_string );
-        auto* ptr_id   = search_field( node, "id", json_type_number );
+static void json_skip( JsonReader* r ) {
+    switch( json_peek( r ) ) {
+        case JsonType::STRING: {
+            json_string( r );
+        } break;
+        case JsonType::NUMBER: {
+            json_number( r );
+        } break;
+        case JsonType::OBJECT: {
+            int    index = 0;
+            String key   = {};
+            while( json_object_next( r, &index, &key ) ) {
+                json_skip( r );
+            }
+        } break;
+        case JsonType::ARRAY: {
+            int index = 0;
+            while( json_array_next( r, &index ) ) {
+                json_skip( r );
+            }
+        } break;
+        case JsonType::TRUE  : json_literal( r, "true" ); break;
+        case JsonType::FALSE : json_literal( r, "false" ); break;
+        case JsonType::NULL_ : json_literal( r, "null" ); break;
+        case JsonType::NONE  : json_error( r, "expected value" );
+    }
+}
+
+// NOTE(alicia): typed reads, on type mismatch value is skipped and treated as missing.
+
+static bool json_read_string( JsonReader* r, String* out ) {
+    if( json_peek( r ) != JsonType::STRING ) {
+        json_skip( r );
+        return false;
+    }
+    *out = json_string( r );
+    return true;
+}
+static bool json_read_number( JsonReader* r, String* out ) {
+    if( json_peek( r ) != JsonType::NUMBER ) {
+        json_skip( r );
+        return false;
+    }
+    *out = json_number( r );
+    return true;
+}
+static bool json_read_bool( JsonReader* r, bool* out ) {
+    switch( json_peek( r ) ) {
+        case JsonType::TRUE: {
+            json_literal( r, "true" );
+            *out = true;
+        } return true;
+        case JsonType::FALSE: {
+            json_literal( r, "false" );
+            *out = false;
+        } return true;
+        default: break;
+    }
+    json_skip( r );
+    return false;
+}
 
-        String type;
+/* same as atoi, stops at first non-digit */
+static int json_number_to_int( String number ) {
+    int  result   = 0;
+    bool negative = false;
 
-        if( !(ptr_type && ptr_id ) ) {
-            goto skip_node;
+    int i = 0;
+    if( i < number.len && (number[i] == '-' || number[i] == '+') ) {
+        negative = number[i] == '-';
+        i++;
+    }
+
+    for( ; i < number.len; ++i ) {
+        if( number[i] < '0' || number[i] > '9' ) {
+            break;
         }
+        result = (result * 10) + (number[i] - '0');
+    }
+
+    return negative ? -result : result;
+}
+static float json_number_to_float( String number ) {
+    double result   = 0.0;
+    bool   negative = false;
+
+    int i = 0;
+    if( i < number.len && (number[i] == '-' || number[i] == '+') ) {
+        negative = number[i] == '-';
+        i++;
+    }
 
-        type = string_from_json( json_value_as_string( ptr_type ) );
-        if( !node_type_from_string( type, &value.type ) ) {
-            goto skip_node;
+    for( ; i < number.len && number[i] >= '0' && number[i] <= '9'; ++i ) {
+        result = (result * 10.0) + (number[i] - '0');
+    }
+
+    if( i < number.len && number[i] == '.' ) {
+        double scale = 0.1;
+        for( ++i; i < number.len && number[i] >= '0' && number[i] <= '9'; ++i ) {
+            result += (number[i] - '0') * scale;
+            scale  *= 0.1;
         }
+    }
 
-        value.id = atoi( json_value_as_number( ptr_id )->number );
-        if( value.id < 0 ) {
-            goto skip_node;
+    if( i < number.len && (number[i] == 'e' || number[i] == 'E') ) {
+        String exponent = advance( number, i + 1 );
+        int    e        = json_number_to_int( exponent );
+
+        for( ; e > 0; --e ) {
+            result *= 10.0;
+        }
+        for( ; e < 0; ++e ) {
+            result /= 10.0;
         }
+    }
 
-        switch( value.type ) {
-            case NodeType::STORY: {
-                auto* ptr_text            = search_field( node, "story.text", json_type_string );
-                auto* ptr_character       = search_field( node, "story.character", json_type_string );
-                auto* ptr_animation_name  = search_field( node, "story.animation.name", json_type_string );
-                auto* ptr_animation_speed = search_field( node, "story.animation.speed", json_type_number );
-                auto* ptr_animation_side  = search_field( node, "story.animation.side", json_type_string );
-                auto* ptr_animation_clear = search_field( node, "story.animation.clear", json_type_true );
-                auto* ptr_write_key       = search_field( node, "story.write.key", json_type_string );
-                auto* ptr_write_value     = search_field( node, "story.write.value", json_type_number );
-
-                if( ptr_text ) {
-                    value.story.text =
-                        string_offset_push(
-                            &sc->string,
-                            string_from_json( json_value_as_string( ptr_text ) ) );
-                }
+    return (float)(negative ? -result : result);
+}
 
-                if( ptr_character ) {
-                    value.story.character =
-                        string_offset_push(
-                            &sc->string,
-                            string_from_json( json_value_as_string( ptr_character ) ) );
-                }
+static int json_hex4( String string, int at ) {
+    if( (at + 4) > string.len ) {
+        return -1;
+    }
 
-                if( ptr_animation_name ) {
-                    value.story.animation.name =
-                        string_offset_push(
-                            &sc->string,
-                            string_from_json( json_value_as_string( ptr_animation_name ) ) );
-                }
+    int result = 0;
+    for( int i = at; i < at + 4; ++i ) {
+        char c = string[i];
+        result <<= 4;
+        if( c >= '0' && c <= '9' ) {
+            result |= c - '0';
+        } else if( c >= 'a' && c <= 'f' ) {
+            result |= (c - 'a') + 10;
+        } else if( c >= 'A' && c <= 'F' ) {
+            result |= (c - 'A') + 10;
+        } else {
+            return -1;
+        }
+    }
+    return result;
+}
 
-                if( ptr_animation_speed ) {
-                    float speed = atof( json_value_as_number( ptr_animation_speed )->number );
-                    if( speed < 0.0f ) {
-                        speed = 0.0f;
-                    }
+/* push string, resolving escapes */
+static StringOffset json_string_push( List<char>* list, String raw ) {
+    if( !find_char( raw, '\\' ) ) {
+        return string_offset_push( list, raw );
+    }
 
-                    value.story.animation.speed = speed;
-                }
+    // NOTE(alicia): resolved string is never longer than escaped string.
+    list->reserve( raw.len + 1 );
 
-                if( ptr_animation_side ) {
-                    String side = string_from_json( json_value_as_string( ptr_animation_side ) );
-                    animation_side_from_string( side, &value.story.animation.side );
-                }
+    StringOffset result = {};
+    result.offset = list->len;
+
+    char* out = list->buf + list->len;
+    int   len = 0;
+
+    for( int i = 0; i < raw.len; ++i ) {
+        char c = raw[i];
+        if( c != '\\' ) {
+            out[len++] = c;
+            continue;
+        }
 
-                if( ptr_animation_clear ) {
-                    if( json_value_is_true( ptr_animation_clear ) ) {
-                        value.story.animation.clear = true;
+        if( ++i >= raw.len ) {
+            break;
+        }
+
+        switch( raw[i] ) {
+            case 'b': out[len++] = '\b'; break;
+            case 'f': out[len++] = '\f'; break;
+            case 'n': out[len++] = '\n'; break;
+            case 'r': out[len++] = '\r'; break;
+            case 't': out[len++] = '\t'; break;
+            case 'u': {
+                int codepoint = json_hex4( raw, i + 1 );
+                if( codepoint < 0 ) {
+                    break;
+                }
+                i += 4;
+
+                if(
+                    codepoint >= 0xD800 && codepoint <= 0xDBFF &&
+                    (i + 2) < raw.len && raw[i + 1] == '\\' && raw[i + 2] == 'u'
+                ) {
+                    int low = json_hex4( raw, i + 3 );
+                    if( low >= 0xDC00 && low <= 0xDFFF ) {
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
                     }
                 }
 
-                if( ptr_write_key ) {
-                    value.story.has_write = true;
-                    value.story.write.key = string_offset_push(
-                        &sc->string, string_from_json( json_value_as_string( ptr_write_key ) ) );
-                    value.story.write.value =
-                        atoi( json_value_as_number( ptr_write_value )->number );
+                if( codepoint < 0x80 ) {
+                    out[len++] = codepoint;
+                } else if( codepoint < 0x800 ) {
+                    out[len++] = 0xC0 | (codepoint >> 6);
+                    out[len++] = 0x80 | (codepoint & 0x3F);
+                } else if( codepoint < 0x10000 ) {
+                    out[len++] = 0xE0 | (codepoint >> 12);
+                    out[len++] = 0x80 | ((codepoint >> 6) & 0x3F);
+                    out[len++] = 0x80 | (codepoint & 0x3F);
+                } else {
+                    out[len++] = 0xF0 | (codepoint >> 18);
+                    out[len++] = 0x80 | ((codepoint >> 12) & 0x3F);
+                    out[len++] = 0x80 | ((codepoint >> 6) & 0x3F);
+                    out[len++] = 0x80 | (codepoint & 0x3F);
                 }
-
             } break;
-            case NodeType::CONTROL: {
-                auto* ptr_type = search_field( node, "control.type", json_type_string );
+            default: {
+                out[len++] = raw[i];
+            } break;
+        }
+    }
 
-                if( !ptr_type ) {
-                    goto skip_node;
-                }
+    out[len]   = 0; // null byte
+    list->len += len + 1;
 
-                if( !control_type_from_string(
-                    string_from_json( json_value_as_string( ptr_type ) ),
-                    &value.control.type
-                ) ) {
-                    goto skip_node;
-                }
+    result.len = len;
+    return result;
+}
 
-                switch( value.control.type ) {
-                    case ControlType::JUMP: {
-                        auto* ptr_scene = search_field( node, "control.jump.scene", json_type_number );
-                        auto* ptr_node  = search_field( node, "control.jump.node", json_type_number );
+// NOTE(alicia): scene keys -------------------------------------------------------------
+
+enum class SceneKey {
+    UNKNOWN,
+
+    ID,
+    TITLE,
+    TREE,
+
+    TYPE,
+    STORY_TEXT,
+    STORY_CHARACTER,
+    STORY_ANIMATION_NAME,
+    STORY_ANIMATION_SPEED,
+    STORY_ANIMATION_SIDE,
+    STORY_ANIMATION_CLEAR,
+    STORY_WRITE_KEY,
+    STORY_WRITE_VALUE,
+    CONTROL_TYPE,
+    CONTROL_JUMP_SCENE,
+    CONTROL_JUMP_NODE,
+    CONTROL_CONDITIONAL_KEY,
+    CONTROL_CONDITIONAL_FALSE,
+    CONTROL_CONDITIONAL_TRUE,
+    WRITE_KEY,
+    WRITE_VALUE,
+    FORK_OPTIONS,
+    FADE_REVERSE,
+
+    SCENE,
+    NODE,
+
+    TEXT,
+    ACTION,
+    JUMP_SCENE,
+    JUMP_NODE,
+};
+
+static SceneKey scene_key_from_string( String key ) {
+    #define KEY( literal, result ) \
+        if( memcmp( key.buf, literal, sizeof(literal) - 1 ) == 0 ) return SceneKey::result
+
+    switch( key.len ) {
+        case 2: {
+            KEY( "id", ID );
+        } break;
+        case 4: {
+            KEY( "type", TYPE );
+            KEY( "text", TEXT );
+            KEY( "tree", TREE );
+            KEY( "node", NODE );
+        } break;
+        case 5: {
+            KEY( "title", TITLE );
+            KEY( "scene", SCENE );
+        } break;
+        case 6: {
+            KEY( "action", ACTION );
+        } break;
+        case 9: {
+            KEY( "write.key", WRITE_KEY );
+            KEY( "jump.node", JUMP_NODE );
+        } break;
+        case 10: {
+            KEY( "story.text", STORY_TEXT );
+            KEY( "jump.scene", JUMP_SCENE );
+        } break;
+        case 11: {
+            KEY( "write.value", WRITE_VALUE );
+        } break;
+        case 12: {
+            KEY( "control.type", CONTROL_TYPE );
+            KEY( "fork.options", FORK_OPTIONS );
+            KEY( "fade.reverse", FADE_REVERSE );
+        } break;
+        case 15: {
+            KEY( "story.character", STORY_CHARACTER );
+            KEY( "story.write.key", STORY_WRITE_KEY );
+        } break;
+        case 17: {
+            KEY( "story.write.value", STORY_WRITE_VALUE );
+            KEY( "control.jump.node", CONTROL_JUMP_NODE );
+        } break;
+        case 18: {
+            KEY( "control.jump.scene", CONTROL_JUMP_SCENE );
+        } break;
+        case 20: {
+            KEY( "story.animation.name", STORY_ANIMATION_NAME );
+            KEY( "story.animation.side", STORY_ANIMATION_SIDE );
+        } break;
+        case 21: {
+            KEY( "story.animation.speed", STORY_ANIMATION_SPEED );
+            KEY( "story.animation.clear", STORY_ANIMATION_CLEAR );
+        } break;
+        case 23: {
+            KEY( "control.conditional.key", CONTROL_CONDITIONAL_KEY );
+        } break;
+        case 24: {
+            KEY( "control.conditional.true", CONTROL_CONDITIONAL_TRUE );
+        } break;
+        case 25: {
+            KEY( "control.conditional.false", CONTROL_CONDITIONAL_FALSE );
+        } break;
+    }
 
-                        if( !ptr_node ) {
-                            goto skip_node;
-                        }
+    #undef KEY
+    return SceneKey::UNKNOWN;
+}
 
-                        if( ptr_scene ) {
-                            value.control.jump.scene =
-                                atoi( json_value_as_number( ptr_scene )->number );
-                        } else {
-                            value.control.jump.scene = -1;
-                        }
+// NOTE(alicia): scene parsing ----------------------------------------------------------
 
-                        value.control.jump.node = atoi( json_value_as_number( ptr_node )->number );
-                    } break;
-                    case ControlType::CONDITIONAL: {
-                        auto* ptr_key = search_field( node, "control.conditional.key", json_type_string );
-                        if( !ptr_key ) {
-                            goto skip_node;
-                        }
+/* values of a node as they appear in source, buf is null if field is missing */
+struct NodeSource {
+    String type, id;
 
-                        value.control.conditional.key = string_offset_push(
-                            &sc->string, string_from_json( json_value_as_string( ptr_key ) ) );
-
-                        auto* ptr_if_false =
-                            search_field( node, "control.conditional.false", json_type_object );
-                        auto* ptr_if_true =
-                            search_field( node, "control.conditional.true", json_type_object );
-
-                        if( ptr_if_false ) {
-                            auto* target   = &value.control.conditional.if_false;
-                            auto* if_false = json_value_as_object( ptr_if_false );
-
-                            if( if_false->length ) {
-                                target->does_something = true;
-                                auto* ptr_scene = search_field( if_false, "scene", json_type_number );
-                                auto* ptr_node  = search_field( if_false, "node", json_type_number );
-
-                                if( ptr_scene ) {
-                                    target->scene = atoi( json_value_as_number( ptr_scene )->number );
-                                } else {
-                                    target->scene = -1;
-                                }
-
-                                if( ptr_node ) {
-                                    target->node = atoi( json_value_as_number( ptr_node )->number );
-                                }
-                            }
-                        }
+    String text, character;
+    String animation_name, animation_speed, animation_side;
+    bool   animation_clear;
+    String story_write_key, story_write_value;
 
-                        if( ptr_if_true ) {
-                            auto* target   = &value.control.conditional.if_true;
-                            auto* if_true = json_value_as_object( ptr_if_true );
-
-                            if( if_true->length ) {
-                                target->does_something = true;
-                                auto* ptr_scene = search_field( if_true, "scene", json_type_number );
-                                auto* ptr_node  = search_field( if_true, "node", json_type_number );
-
-                                if( ptr_scene ) {
-                                    target->scene = atoi( json_value_as_number( ptr_scene )->number );
-                                } else {
-                                    target->scene = -1;
-                                }
-
-                                if( ptr_node ) {
-                                    target->node = atoi( json_value_as_number( ptr_node )->number );
-                                }
-                            }
-                        }
-                    } break;
-                    case ControlType::COUNT:
-                        break;
+    String control_type;
+    String jump_scene, jump_node;
+    String conditional_key;
+
+    struct {
+        bool   is_present, is_empty;
+        String scene, node;
+    } if_false, if_true;
+
+    String write_key, write_value;
+
+    bool has_options;
+    int  option_count;
+
+    bool fade_reverse;
+};
+
+static void scene_parse_conditional_jump( JsonReader* r, bool* out_present, bool* out_empty, String* out_scene, String* out_node ) {
+    if( json_peek( r ) != JsonType::OBJECT ) {
+        json_skip( r );
+        return;
+    }
+
+    *out_present = true;
+    *out_empty   = true;
+
+    int    index = 0;
+    String key   = {};
+    while( json_object_next( r, &index, &key ) ) {
+        *out_empty = false;
+        switch( scene_key_from_string( key ) ) {
+            case SceneKey::SCENE: json_read_number( r, out_scene ); break;
+            case SceneKey::NODE : json_read_number( r, out_node ); break;
+            default: json_skip( r ); break;
+        }
+    }
+}
+
+static void scene_parse_fork_option( JsonReader* r, Scene* sc, InternTable* keys ) {
+    ForkOption fo = {};
+
+    String text, action, jump_scene, jump_node, write_key, write_value;
+    text = action = jump_scene = jump_node = write_key = write_value = {};
+
+    int    index = 0;
+    String key   = {};
+    while( json_object_next( r, &index, &key ) ) {
+        switch( scene_key_from_string( key ) ) {
+            case SceneKey::TEXT        : json_read_string( r, &text ); break;
+            case SceneKey::ACTION      : json_read_string( r, &action ); break;
+            case SceneKey::JUMP_SCENE  : json_read_number( r, &jump_scene ); break;
+            case SceneKey::JUMP_NODE   : json_read_number( r, &jump_node ); break;
+            case SceneKey::WRITE_KEY   : json_read_string( r, &write_key ); break;
+            case SceneKey::WRITE_VALUE : json_read_number( r, &write_value ); break;
+            default: json_skip( r ); break;
+        }
+    }
+
+    if( text.buf ) {
+        fo.text = json_string_push( &sc->string, text );
+    }
+
+    if( action.buf && fork_action_type_from_string( action, &fo.type ) ) {
+        switch( fo.type ) {
+            case ForkActionType::JUMP: {
+                if( !jump_node.buf ) {
+                    fo.type = ForkActionType::NONE;
+                    break;
                 }
+
+                fo.jump.scene = jump_scene.buf ? json_number_to_int( jump_scene ) : -1;
+                fo.jump.node  = json_number_to_int( jump_node );
             } break;
-            case NodeType::WRITE: {
-                auto* ptr_key   = search_field( node, "write.key", json_type_string );
-                auto* ptr_value = search_field( node, "write.value", json_type_number );
+            case ForkActionType::WRITE: {
+                if( !(write_key.buf && write_value.buf) ) {
+                    fo.type = ForkActionType::NONE;
+                    break;
+                }
+
+                fo.write.key   = keys->intern( write_key );
+                fo.write.value = json_number_to_int( write_value );
+            } break;
+
+            case ForkActionType::NONE:
+            case ForkActionType::COUNT:
+                break;
+        }
+    }
+
+    sc->storage.append( sizeof(fo), (char*)&fo );
+}
 
-                if( !ptr_key ) {
-                    goto skip_node;
+static void scene_parse_node( JsonReader* r, Scene* sc, InternTable* keys ) {
+    NodeSource src     = {};
+    NodeType   type    = NodeType::NONE;
+    int        id      = -1;
+    int        payload = -1;
+
+    StoryNode   story   = {};
+    ControlNode control = {};
+    WriteNode   write   = {};
+    ForkNode    fork    = {};
+    FadeNode    fade    = {};
+
+    int string_mark  = sc->string.len;
+    int storage_mark = sc->storage.len;
+
+    int    index = 0;
+    String key   = {};
+    while( json_object_next( r, &index, &key ) ) {
+        switch( scene_key_from_string( key ) ) {
+            case SceneKey::TYPE                  : json_read_string( r, &src.type ); break;
+            case SceneKey::ID                    : json_read_number( r, &src.id ); break;
+            case SceneKey::STORY_TEXT            : json_read_string( r, &src.text ); break;
+            case SceneKey::STORY_CHARACTER       : json_read_string( r, &src.character ); break;
+            case SceneKey::STORY_ANIMATION_NAME  : json_read_string( r, &src.animation_name ); break;
+            case SceneKey::STORY_ANIMATION_SPEED : json_read_number( r, &src.animation_speed ); break;
+            case SceneKey::STORY_ANIMATION_SIDE  : json_read_string( r, &src.animation_side ); break;
+            case SceneKey::STORY_ANIMATION_CLEAR : json_read_bool( r, &src.animation_clear ); break;
+            case SceneKey::STORY_WRITE_KEY       : json_read_string( r, &src.story_write_key ); break;
+            case SceneKey::STORY_WRITE_VALUE     : json_read_number( r, &src.story_write_value ); break;
+            case SceneKey::CONTROL_TYPE          : json_read_string( r, &src.control_type ); break;
+            case SceneKey::CONTROL_JUMP_SCENE    : json_read_number( r, &src.jump_scene ); break;
+            case SceneKey::CONTROL_JUMP_NODE     : json_read_number( r, &src.jump_node ); break;
+            case SceneKey::CONTROL_CONDITIONAL_KEY: json_read_string( r, &src.conditional_key ); break;
+            case SceneKey::CONTROL_CONDITIONAL_FALSE: {
+                scene_parse_conditional_jump(
+                    r, &src.if_false.is_present, &src.if_false.is_empty,
+                    &src.if_false.scene, &src.if_false.node );
+            } break;
+            case SceneKey::CONTROL_CONDITIONAL_TRUE: {
+                scene_parse_conditional_jump(
+                    r, &src.if_true.is_present, &src.if_true.is_empty,
+                    &src.if_true.scene, &src.if_true.node );
+            } break;
+            case SceneKey::WRITE_KEY    : json_read_string( r, &src.write_key ); break;
+            case SceneKey::WRITE_VALUE  : json_read_number( r, &src.write_value ); break;
+            case SceneKey::FADE_REVERSE : json_read_bool( r, &src.fade_reverse ); break;
+            case SceneKey::FORK_OPTIONS : {
+                if( json_peek( r ) != JsonType::ARRAY ) {
+                    json_skip( r );
+                    break;
                 }
 
-                value.write.key = string_offset_push(
-                    &sc->string, string_from_json( json_value_as_string( ptr_key ) ) );
-                if( ptr_value ) {
-                    value.write.value =
-                        atoi( json_value_as_number( ptr_value )->number );
+                // NOTE(alicia): options are written to storage as they are read,
+                // rolled back below if this node does not turn out to be a fork.
+                src.has_options = true;
+
+                int option_index = 0;
+                while( json_array_next( r, &option_index ) ) {
+                    if( json_peek( r ) != JsonType::OBJECT ) {
+                        json_skip( r );
+                        continue;
+                    }
+                    scene_parse_fork_option( r, sc, keys );
+                    src.option_count++;
                 }
             } break;
-            case NodeType::FORK: {
-                auto* ptr_options = search_field( node, "fork.options", json_type_array );
-                if( !ptr_options ) {
-                    goto skip_node;
+            default: json_skip( r ); break;
+        }
+    }
+
+    if( !(src.type.buf && src.id.buf) ) {
+        goto skip_node;
+    }
+    if( !node_type_from_string( src.type, &type ) ) {
+        goto skip_node;
+    }
+
+    id = json_number_to_int( src.id );
+    if( id < 0 ) {
+        TraceLog( LOG_WARNING, "%s: node with negative id %i skipped.", r->path, id );
+        goto skip_node;
+    }
+
+    if( type != NodeType::FORK ) {
+        sc->string.len  = string_mark;
+        sc->storage.len = storage_mark;
+    }
+
+    switch( type ) {
+        case NodeType::STORY: {
+            if( src.text.buf ) {
+                story.text = json_string_push( &sc->string, src.text );
+            }
+            if( src.character.buf ) {
+                story.character = json_string_push( &sc->string, src.character );
+            }
+            if( src.animation_name.len ) {
+                int animation = ANIM_NONE;
+                if( animation_from_string( src.animation_name, &animation ) ) {
+                    story.animation.id = (u16)animation;
+                } else {
+                    int line = 0, column = 0;
+                    json_location( r, src.animation_name.buf, &line, &column );
+                    TraceLog(
+                        LOG_WARNING, "%s:%i:%i: node %i: unknown animation '%.*s'!",
+                        r->path, line, column, id,
+                        src.animation_name.len, src.animation_name.buf );
                 }
-                auto* options = json_value_as_array( ptr_options );
+            }
+
+            if( src.animation_speed.buf ) {
+                float speed = json_number_to_float( src.animation_speed );
+                if( speed < 0.0f ) {
+                    speed = 0.0f;
+                }
+
+                story.animation.speed = speed;
+            }
 
-                value.fork.byte_offset = sc->storage.len;
+            if( src.animation_side.buf ) {
+                animation_side_from_string( src.animation_side, &story.animation.side );
+            }
+
+            story.animation.clear = src.animation_clear;
 
-                auto* at_option = options->start;
-                for( size_t j = 0; j < options->length; ++j ) {
-                    auto* current = json_value_as_object( at_option->value );
-                    ForkOption fo = {};
+            if( src.story_write_key.buf ) {
+                story.has_write   = true;
+                story.write.key   = keys->intern( src.story_write_key );
+                story.write.value = json_number_to_int( src.story_write_value );
+            }
+        } break;
+        case NodeType::CONTROL: {
+            if( !src.control_type.buf ) {
+                goto skip_node;
+            }
+            if( !control_type_from_string( src.control_type, &control.type ) ) {
+                goto skip_node;
+            }
 
-                    json_value_s* ptr_text, *ptr_action;
-                    ptr_text = ptr_action = nullptr;
+            switch( control.type ) {
+                case ControlType::JUMP: {
+                    if( !src.jump_node.buf ) {
+                        goto skip_node;
+                    }
 
-                    if( !current ) {
-                        goto skip_option;
+                    control.jump.scene =
+                        src.jump_scene.buf ? json_number_to_int( src.jump_scene ) : -1;
+                    control.jump.node = json_number_to_int( src.jump_node );
+                } break;
+                case ControlType::CONDITIONAL: {
+                    if( !src.conditional_key.buf ) {
+                        goto skip_node;
                     }
 
-                    ptr_text   = search_field( current, "text", json_type_string );
-                    ptr_action = search_field( current, "action", json_type_string );
+                    control.conditional.key = keys->intern( src.conditional_key );
 
-                    if( ptr_text ) {
-                        fo.text = string_offset_push(
-                            &sc->string, string_from_json( json_value_as_string( ptr_text ) ) );
+                    auto* if_false = &control.conditional.if_false;
+                    if( src.if_false.is_present && !src.if_false.is_empty ) {
+                        if_false->does_something = true;
+                        if_false->scene =
+                            src.if_false.scene.buf ? json_number_to_int( src.if_false.scene ) : -1;
+                        if_false->node  = json_number_to_int( src.if_false.node );
                     }
 
-                    if( ptr_action ) {
-                        String str_action = string_from_json( json_value_as_string( ptr_action ) );
-                        if( fork_action_type_from_string( str_action, &fo.type ) ) {
-                            switch( fo.type ) {
-                                case ForkActionType::JUMP: {
-                                    auto* ptr_scene =
-                                        search_field( current, "jump.scene", json_type_number );
-                                    auto* ptr_node =
-                                        search_field( current, "jump.node", json_type_number );
-
-                                    if( !ptr_node ) {
-                                        fo.type = ForkActionType::NONE;
-                                    }
-
-                                    if( ptr_scene ) {
-                                        fo.jump.scene =
-                                            atoi( json_value_as_number( ptr_scene )->number );
-                                    } else {
-                                        fo.jump.scene = -1;
-                                    }
-
-                                    fo.jump.node = atoi( json_value_as_number( ptr_node )->number );
-                                } break;
-                                case ForkActionType::WRITE: {
-                                    auto* ptr_key =
-                                        search_field( current, "write.key", json_type_string );
-                                    auto* ptr_value =
-                                        search_field( current, "write.value", json_type_number );
-
-                                    if( !(ptr_key && ptr_value) ) {
-                                        fo.type = ForkActionType::NONE;
-                                    }
-
-                                    fo.write.key = string_offset_push(
-                                        &sc->string, string_from_json(
-                                            json_value_as_string( ptr_key ) ) );
-                                    fo.write.value =
-                                        atoi( json_value_as_number( ptr_value )->number );
-                                } break;
-
-                                case ForkActionType::NONE:
-                                case ForkActionType::COUNT:
-                                    break;
-                            }
-                        }
+                    auto* if_true = &control.conditional.if_true;
+                    if( src.if_true.is_present && !src.if_true.is_empty ) {
+                        if_true->does_something = true;
+                        if_true->scene =
+                            src.if_true.scene.buf ? json_number_to_int( src.if_true.scene ) : -1;
+                        if_true->node  = json_number_to_int( src.if_true.node );
                     }
+                } break;
+                case ControlType::COUNT:
+                    break;
+            }
+        } break;
+        case NodeType::WRITE: {
+            if( !src.write_key.buf ) {
+                goto skip_node;
+            }
+
+            write.key   = keys->intern( src.write_key );
+            write.value = json_number_to_int( src.write_value );
+        } break;
+        case NodeType::FORK: {
+            if( !src.has_options ) {
+                goto skip_node;
+            }
 
-                    sc->storage.append( sizeof(fo), (char*)&fo );
-                    value.fork.len++;
+            fork.byte_offset = storage_mark;
+            fork.len         = src.option_count;
+        } break;
+        case NodeType::FADE: {
+            fade.reverse = src.fade_reverse;
+        } break;
 
-                skip_option:
-                    at_option = at_option->next;
+        case NodeType::NONE:
+        case NodeType::COUNT: goto skip_node;
+    }
+
+    switch( type ) {
+        case NodeType::STORY   : payload = sc->stories.push( story ); break;
+        case NodeType::CONTROL : payload = sc->controls.push( control ); break;
+        case NodeType::WRITE   : payload = sc->writes.push( write ); break;
+        case NodeType::FORK    : payload = sc->forks.push( fork ); break;
+        case NodeType::FADE    : payload = sc->fades.push( fade ); break;
+
+        case NodeType::NONE:
+        case NodeType::COUNT: goto skip_node;
+    }
+
+    sc->types.push( type );
+    sc->ids.push( id );
+    sc->payloads.push( payload );
+    return;
+
+skip_node:
+    sc->string.len  = string_mark;
+    sc->storage.len = storage_mark;
+}
+
+// NOTE(alicia): sizes scene lists from upper bounds taken from source
+// so that parsing does not have to grow them.
+// every node and fork option is an object so there are at most as many of them
+// as there are '{' in source and strings can only get shorter once unescaped,
+// a string's quotes make up for its null terminator.
+static void scene_parse_reserve( String source, Scene* sc ) {
+    int    objects = 0;
+    String rest    = source;
+
+    int index = 0;
+    while( find_char( rest, '{', &index ) ) {
+        objects++;
+        rest = advance( rest, index + 1 );
+    }
+
+    // NOTE(alicia): story nodes make up most of a scene so only their pool
+    // is sized up front, other pools are small and grow as needed.
+    sc->types.reserve( objects );
+    sc->ids.reserve( objects );
+    sc->payloads.reserve( objects );
+    sc->stories.reserve( objects );
+    sc->storage.reserve( objects * (int)sizeof(ForkOption) );
+    sc->string.reserve( source.len );
+}
+
+void scene_parse( const char* path, String source, Scene* sc ) {
+    JsonReader r = {};
+    r.path  = path;
+    r.start = r.at = source.buf;
+    r.end   = source.buf + source.len;
+
+    sc->reset();
+    scene_parse_reserve( source, sc );
+
+    // NOTE(alicia): keys are collected separately from scene string
+    // so that rolling back a skipped node does not remove them.
+    InternTable keys = {};
+
+    bool has_id   = false;
+    bool has_tree = false;
+
+    if( json_peek( &r ) != JsonType::OBJECT ) {
+        json_error( &r, "scene must be an object" );
+    }
+
+    int    index = 0;
+    String key   = {};
+    while( json_object_next( &r, &index, &key ) ) {
+        switch( scene_key_from_string( key ) ) {
+            case SceneKey::ID: {
+                String id = {};
+                if( json_read_number( &r, &id ) ) {
+                    has_id = true;
+                    sc->id = json_number_to_int( id );
                 }
+            } break;
+            case SceneKey::TITLE: {
+                String title = {};
+                if( json_read_string( &r, &title ) ) {
+                    sc->title = json_string_push( &sc->string, title );
+                }
+            } break;
+            case SceneKey::TREE: {
+                if( json_peek( &r ) != JsonType::ARRAY ) {
+                    json_skip( &r );
+                    break;
+                }
+                has_tree = true;
 
+                int node_index = 0;
+                while( json_array_next( &r, &node_index ) ) {
+                    if( json_peek( &r ) != JsonType::OBJECT ) {
+                        json_error( &r, "tree nodes must be objects" );
+                    }
+                    scene_parse_node( &r, sc, &keys );
+                }
             } break;
+            default: json_skip( &r ); break;
+        }
+    }
 
-            case NodeType::FADE: {
-                auto* ptr_reverse = search_field( node, "fade.reverse", json_type_true );
+    Assert( has_id && has_tree, "%s: scene requires 'id' and 'tree' fields!", path );
+
+    sc->keys.reserve( keys.count() );
+    for( int i = 0; i < keys.count(); ++i ) {
+        sc->keys.push( json_string_push( &sc->string, keys.get( i ) ) );
+    }
+    keys.free();
+
+    scene_build_lookup( sc );
+    scene_link( path, sc );
+}
+
+static void scene_load_json( const char* path, Scene* sc ) {
+    int   size = 0;
+    char* data = (char*)LoadFileData( path, &size );
+    Assert( data, "%s: failed to read scene!", path );
+
+    scene_parse( path, String( size, data ), sc );
+
+    UnloadFileData( (unsigned char*)data );
+}
+
+static bool scene_read_id_compiled( const char* path, int* out_id ) {
+    FILE* file = fopen( path, "rb" );
+    if( !file ) {
+        return false;
+    }
+
+    SceneCompiledHeader header = {};
+    bool is_valid =
+        fread( &header, sizeof(header), 1, file ) == 1 &&
+        header.magic   == SCENE_COMPILED_MAGIC &&
+        header.version == SCENE_COMPILED_VERSION;
+    fclose( file );
+
+    if( is_valid ) {
+        *out_id = header.id;
+    }
+    return is_valid;
+}
+
+// NOTE(alicia): only top level of scene is read, tree is skipped over
+// without pushing anything so nothing has to be allocated.
+bool scene_read_id( const char* path, int* out_id ) {
+    PROFILE_ZONE( "scene_read_id" );
+
+    if( IsFileExtension( path, SCENE_COMPILED_EXT ) ) {
+        return scene_read_id_compiled( path, out_id );
+    }
+
+    const char* compiled = scene_compiled_sibling( path );
+    if( compiled && scene_read_id_compiled( compiled, out_id ) ) {
+        return true;
+    }
+
+    int   size = 0;
+    char* data = (char*)LoadFileData( path, &size );
+    if( !data ) {
+        return false;
+    }
+
+    JsonReader r = {};
+    r.path  = path;
+    r.start = r.at = data;
+    r.end   = data + size;
+
+    bool has_id = false;
+    if( json_peek( &r ) == JsonType::OBJECT ) {
+        int    index = 0;
+        String key   = {};
+        while( json_object_next( &r, &index, &key ) ) {
+            String id = {};
+            if(
+                scene_key_from_string( key ) == SceneKey::ID &&
+                json_read_number( &r, &id )
+            ) {
+                has_id  = true;
+                *out_id = json_number_to_int( id );
+                break;
+            }
+            json_skip( &r );
+        }
+    }
+
+    UnloadFileData( (unsigned char*)data );
+    return has_id;
+}
+
+static u32 scene_compiled_section(
+    List<char>* out, SceneSection* section, int len, int size, const void* items
+) {
+    int padding = (SCENE_COMPILED_ALIGN - (out->len % SCENE_COMPILED_ALIGN)) % SCENE_COMPILED_ALIGN;
+    out->reserve( padding );
+    memset( out->buf + out->len, 0, padding );
+    out->len += padding;
+
+    section->offset = out->len;
+    section->len    = len;
+
+    if( len ) {
+        out->append( len * size, (const char*)items );
+    }
+
+    return section->offset;
+}
+
+bool scene_compile( const char* src_path, const char* dst_path ) {
+    Scene sc = {};
+    scene_load_json( src_path, &sc );
+
+    SceneCompiledHeader header = {};
+    header.magic                = SCENE_COMPILED_MAGIC;
+    header.version              = SCENE_COMPILED_VERSION;
+    header.story_size           = sizeof(StoryNode);
+    header.control_size         = sizeof(ControlNode);
+    header.fork_option_size     = sizeof(ForkOption);
+    header.animation_count      = ANIM_COUNT;
+    header.animation_names_hash = ANIMATION_NAMES_HASH;
+    header.id                   = sc.id;
+    header.title                = sc.title;
+
+    List<char> out = {};
+    out.append( sizeof(header), (const char*)&header );
+
+    scene_compiled_section(
+        &out, &header.types, sc.types.len, sizeof(NodeType), sc.types.buf );
+    scene_compiled_section(
+        &out, &header.ids, sc.ids.len, sizeof(int), sc.ids.buf );
+    scene_compiled_section(
+        &out, &header.payloads, sc.payloads.len, sizeof(int), sc.payloads.buf );
+    scene_compiled_section(
+        &out, &header.stories, sc.stories.len, sizeof(StoryNode), sc.stories.buf );
+    scene_compiled_section(
+        &out, &header.controls, sc.controls.len, sizeof(ControlNode), sc.controls.buf );
+    scene_compiled_section(
+        &out, &header.writes, sc.writes.len, sizeof(WriteNode), sc.writes.buf );
+    scene_compiled_section(
+        &out, &header.forks, sc.forks.len, sizeof(ForkNode), sc.forks.buf );
+    scene_compiled_section(
+        &out, &header.fades, sc.fades.len, sizeof(FadeNode), sc.fades.buf );
+    scene_compiled_section(
+        &out, &header.string, sc.string.len, sizeof(char), sc.string.buf );
+    scene_compiled_section(
+        &out, &header.storage, sc.storage.len, sizeof(char), sc.storage.buf );
+    scene_compiled_section(
+        &out, &header.lookup, sc.lookup.len, sizeof(int), sc.lookup.buf );
+    scene_compiled_section(
+        &out, &header.keys, sc.keys.len, sizeof(StringOffset), sc.keys.buf );
+
+    memcpy( out.buf, &header, sizeof(header) );
+
+    bool result = SaveFileData( dst_path, out.buf, out.len );
+
+    out.free();
+    sc.free();
+
+    return result;
+}
+
+static bool scene_section_is_valid( SceneSection section, int size, usize file_size ) {
+    if( section.offset % SCENE_COMPILED_ALIGN ) {
+        return false;
+    }
+    return ((usize)section.offset + ((usize)section.len * size)) <= file_size;
+}
+
+static bool scene_compiled_string_is_valid( StringOffset string, const SceneCompiledHeader* header ) {
+    return
+        string.len >= 0 && string.offset >= 0 &&
+        ((usize)string.offset + (usize)string.len) <= header->string.len;
+}
+static bool scene_compiled_key_is_valid( int key, const SceneCompiledHeader* header ) {
+    return key >= 0 && (u32)key < header->keys.len;
+}
+// linked jumps are -1 when they go to another scene or nowhere.
+static bool scene_compiled_index_is_valid( int index, const SceneCompiledHeader* header ) {
+    return index >= -1 && index < (int)header->types.len;
+}
+
+// every node must point at a payload of its type and every
+// string, key, storage offset and jump in a payload must be in range.
+static bool scene_compiled_nodes_are_valid( const SceneCompiledHeader* header, void* base ) {
+    if(
+        header->ids.len      != header->types.len ||
+        header->payloads.len != header->types.len
+    ) {
+        return false;
+    }
+
+    auto* types    = (const NodeType*)((u8*)base + header->types.offset);
+    auto* payloads = (const int*)((u8*)base + header->payloads.offset);
+    for( u32 i = 0; i < header->types.len; ++i ) {
+        u32 pool = 0;
+        switch( types[i] ) {
+            case NodeType::STORY   : pool = header->stories.len; break;
+            case NodeType::CONTROL : pool = header->controls.len; break;
+            case NodeType::WRITE   : pool = header->writes.len; break;
+            case NodeType::FORK    : pool = header->forks.len; break;
+            case NodeType::FADE    : pool = header->fades.len; break;
+
+            case NodeType::NONE:
+            case NodeType::COUNT:
+                return false;
+        }
+        if( payloads[i] < 0 || (u32)payloads[i] >= pool ) {
+            return false;
+        }
+    }
+
+    if( !scene_compiled_string_is_valid( header->title, header ) ) {
+        return false;
+    }
+
+    auto* keys = (const StringOffset*)((u8*)base + header->keys.offset);
+    for( u32 i = 0; i < header->keys.len; ++i ) {
+        if( !scene_compiled_string_is_valid( keys[i], header ) ) {
+            return false;
+        }
+    }
+
+    auto* stories = (const StoryNode*)((u8*)base + header->stories.offset);
+    for( u32 i = 0; i < header->stories.len; ++i ) {
+        auto* story = stories + i;
+        if(
+            !scene_compiled_string_is_valid( story->text, header )      ||
+            !scene_compiled_string_is_valid( story->character, header ) ||
+            story->animation.id >= ANIM_COUNT                           ||
+            (u32)story->animation.side >= (u32)AnimationSide::COUNT     ||
+            (story->has_write && !scene_compiled_key_is_valid( story->write.key, header ))
+        ) {
+            return false;
+        }
+    }
 
-                if( ptr_reverse ) {
-                    if( json_value_is_true( ptr_reverse ) ) {
-                        value.fade.reverse = true;
+    auto* controls = (const ControlNode*)((u8*)base + header->controls.offset);
+    for( u32 i = 0; i < header->controls.len; ++i ) {
+        auto* control = controls + i;
+        switch( control->type ) {
+            case ControlType::JUMP: {
+                if( !scene_compiled_index_is_valid( control->jump.index, header ) ) {
+                    return false;
+                }
+            } break;
+            case ControlType::CONDITIONAL: {
+                auto* c = &control->conditional;
+                if(
+                    !scene_compiled_key_is_valid( c->key, header )              ||
+                    !scene_compiled_index_is_valid( c->if_false.index, header ) ||
+                    !scene_compiled_index_is_valid( c->if_true.index, header )
+                ) {
+                    return false;
+                }
+            } break;
+            case ControlType::COUNT:
+            default:
+                return false;
+        }
+    }
+
+    auto* writes = (const WriteNode*)((u8*)base + header->writes.offset);
+    for( u32 i = 0; i < header->writes.len; ++i ) {
+        if( !scene_compiled_key_is_valid( writes[i].key, header ) ) {
+            return false;
+        }
+    }
+
+    auto* forks   = (const ForkNode*)((u8*)base + header->forks.offset);
+    auto* storage = (const u8*)base + header->storage.offset;
+    for( u32 i = 0; i < header->forks.len; ++i ) {
+        auto* fork = forks + i;
+        if(
+            fork->byte_offset < 0 || fork->len < 0 ||
+            (fork->byte_offset % alignof(ForkOption)) ||
+            ((usize)fork->byte_offset + ((usize)fork->len * sizeof(ForkOption))) > header->storage.len
+        ) {
+            return false;
+        }
+
+        auto* options = (const ForkOption*)(storage + fork->byte_offset);
+        for( int j = 0; j < fork->len; ++j ) {
+            auto* option = options + j;
+            if( !scene_compiled_string_is_valid( option->text, header ) ) {
+                return false;
+            }
+            switch( option->type ) {
+                case ForkActionType::NONE:
+                    break;
+                case ForkActionType::JUMP: {
+                    if( !scene_compiled_index_is_valid( option->jump.index, header ) ) {
+                        return false;
+                    }
+                } break;
+                case ForkActionType::WRITE: {
+                    if( !scene_compiled_key_is_valid( option->write.key, header ) ) {
+                        return false;
+                    }
+                } break;
+                case ForkActionType::COUNT:
+                default:
+                    return false;
+            }
+        }
+    }
+
+    // NOTE(alicia): lookup needs an empty slot so that probes end.
+    u32 slot_count = header->lookup.len;
+    if( header->types.len ) {
+        if( (slot_count & (slot_count - 1)) || slot_count <= header->types.len ) {
+            return false;
+        }
+    } else if( slot_count ) {
+        return false;
+    }
+
+    auto* lookup = (const int*)((u8*)base + header->lookup.offset);
+    for( u32 i = 0; i < slot_count; ++i ) {
+        if( lookup[i] < -1 || lookup[i] >= (int)header->types.len ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+static void scene_section_map( List<T>* list, SceneSection section, void* base ) {
+    list->buf = section.len ? (T*)((u8*)base + section.offset) : nullptr;
+    list->len = list->cap = section.len;
+}
+
+static bool scene_load_compiled( const char* path, Scene* sc ) {
+    void* data = nullptr;
+    usize size = 0;
+
+#if defined(SCENE_USE_MMAP)
+    int fd = open( path, O_RDONLY );
+    if( fd < 0 ) {
+        return false;
+    }
+
+    struct stat st = {};
+    if( fstat( fd, &st ) != 0 || st.st_size < (off_t)sizeof(SceneCompiledHeader) ) {
+        close( fd );
+        return false;
+    }
+
+    size = st.st_size;
+    // NOTE(alicia): private mapping so that pages are copy on write,
+    // scene data is never written to but Node payloads are handed out as mutable.
+    data = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+
+    if( data == MAP_FAILED ) {
+        return false;
+    }
+#else
+    int data_size = 0;
+    data = LoadFileData( path, &data_size );
+    if( !data ) {
+        return false;
+    }
+    size = data_size;
+#endif
+
+    sc->reset();
+
+    sc->mapping      = data;
+    sc->mapping_size = size;
+
+    if( size < sizeof(SceneCompiledHeader) ) {
+        scene_unmap( sc );
+        return false;
+    }
+
+    auto* header = (SceneCompiledHeader*)data;
+    if(
+        header->magic                != SCENE_COMPILED_MAGIC   ||
+        header->version              != SCENE_COMPILED_VERSION ||
+        header->story_size           != sizeof(StoryNode)      ||
+        header->control_size         != sizeof(ControlNode)    ||
+        header->fork_option_size     != sizeof(ForkOption)     ||
+        header->animation_count      != ANIM_COUNT             ||
+        header->animation_names_hash != ANIMATION_NAMES_HASH   ||
+        !scene_section_is_valid( header->types, sizeof(NodeType), size )       ||
+        !scene_section_is_valid( header->ids, sizeof(int), size )              ||
+        !scene_section_is_valid( header->payloads, sizeof(int), size )         ||
+        !scene_section_is_valid( header->stories, sizeof(StoryNode), size )    ||
+        !scene_section_is_valid( header->controls, sizeof(ControlNode), size ) ||
+        !scene_section_is_valid( header->writes, sizeof(WriteNode), size )     ||
+        !scene_section_is_valid( header->forks, sizeof(ForkNode), size )       ||
+        !scene_section_is_valid( header->fades, sizeof(FadeNode), size )       ||
+        !scene_section_is_valid( header->string, sizeof(char), size )  ||
+        !scene_section_is_valid( header->storage, sizeof(char), size ) ||
+        !scene_section_is_valid( header->lookup, sizeof(int), size )   ||
+        !scene_section_is_valid( header->keys, sizeof(StringOffset), size )    ||
+        !scene_compiled_nodes_are_valid( header, data )
+    ) {
+        scene_unmap( sc );
+        return false;
+    }
+
+    sc->id    = header->id;
+    sc->title = header->title;
+
+    scene_section_map( &sc->types, header->types, data );
+    scene_section_map( &sc->ids, header->ids, data );
+    scene_section_map( &sc->payloads, header->payloads, data );
+    scene_section_map( &sc->stories, header->stories, data );
+    scene_section_map( &sc->controls, header->controls, data );
+    scene_section_map( &sc->writes, header->writes, data );
+    scene_section_map( &sc->forks, header->forks, data );
+    scene_section_map( &sc->fades, header->fades, data );
+    scene_section_map( &sc->string, header->string, data );
+    scene_section_map( &sc->storage, header->storage, data );
+    scene_section_map( &sc->lookup, header->lookup, data );
+    scene_section_map( &sc->keys, header->keys, data );
+
+    return true;
+}
+
+void scene_unmap( Scene* sc ) {
+    if( sc->mapping ) {
+#if defined(SCENE_USE_MMAP)
+        munmap( sc->mapping, sc->mapping_size );
+#else
+        UnloadFileData( (unsigned char*)sc->mapping );
+#endif
+    }
+
+    sc->mapping      = nullptr;
+    sc->mapping_size = 0;
+
+    sc->types    = {};
+    sc->ids      = {};
+    sc->payloads = {};
+    sc->stories  = {};
+    sc->controls = {};
+    sc->writes   = {};
+    sc->forks    = {};
+    sc->fades    = {};
+    sc->string   = {};
+    sc->storage  = {};
+    sc->lookup   = {};
+    sc->keys     = {};
+}
+
+// NOTE(alicia): ids are sparse, scene-01 goes up to 100022 with 381 nodes,
+// so ids are hashed instead of indexing a table by id.
+void scene_build_lookup( Scene* sc ) {
+    sc->lookup.reset();
+    if( !sc->ids.len ) {
+        return;
+    }
+
+    int slot_count = 8;
+    while( slot_count < (sc->ids.len * 2) ) {
+        slot_count *= 2;
+    }
+
+    sc->lookup.reserve( slot_count );
+    sc->lookup.len = slot_count;
+
+    // NOTE(alicia): all bits set == -1
+    memset( sc->lookup.buf, 0xFF, sizeof(int) * sc->lookup.len );
+
+    u32 mask = slot_count - 1;
+    for( int i = 0; i < sc->ids.len; ++i ) {
+        int id = sc->ids[i];
+        Assert( id >= 0, "node %i has a negative id!", id );
+
+        // NOTE(alicia): first node with a given id wins, same as old linear search.
+        for( u32 at = scene_node_id_hash( id ) & mask;; at = (at + 1) & mask ) {
+            int* slot = sc->lookup + at;
+            if( *slot < 0 ) {
+                *slot = i;
+                break;
+            }
+            if( sc->ids[*slot] == id ) {
+                break;
+            }
+        }
+    }
+}
+
+// NOTE(alicia): compiled scenes are linked when they are compiled,
+// so loading one does not write to its mapping.
+void scene_link( const char* path, Scene* sc ) {
+    auto resolve = [&]( int from, int scene_id, int node_id ) -> int {
+        if( scene_is_other( sc, scene_id ) ) {
+            return -1;
+        }
+
+        int index = sc->index_of( node_id );
+        if( index < 0 ) {
+            Panic(
+                "%s: node %i jumps to node %i which does not exist!",
+                path, sc->ids[from], node_id );
+        }
+        return index;
+    };
+
+    for( int i = 0; i < sc->node_count(); ++i ) {
+        Node node = sc->node( i );
+        int  next = (i + 1) < sc->node_count() ? (i + 1) : -1;
+
+        switch( node.type ) {
+            case NodeType::CONTROL: switch( node.control->type ) {
+                case ControlType::JUMP: {
+                    auto* j  = &node.control->jump;
+                    j->index = resolve( i, j->scene, j->node );
+                } break;
+                case ControlType::CONDITIONAL: {
+                    ConditionalJump* jumps[] = {
+                        &node.control->conditional.if_false,
+                        &node.control->conditional.if_true,
+                    };
+                    for( auto* j : jumps ) {
+                        j->index = j->does_something ? resolve( i, j->scene, j->node ) : next;
+                    }
+                } break;
+                case ControlType::COUNT:
+                    break;
+            } break;
+            case NodeType::FORK: {
+                auto* options = (ForkOption*)(sc->storage + node.fork->byte_offset);
+                for( int j = 0; j < node.fork->len; ++j ) {
+                    auto* option = options + j;
+                    if( option->type == ForkActionType::JUMP ) {
+                        option->jump.index = resolve( i, option->jump.scene, option->jump.node );
                     }
                 }
             } break;
 
             case NodeType::NONE:
-            case NodeType::COUNT: goto skip_node;
+            case NodeType::STORY:
+            case NodeType::WRITE:
+            case NodeType::FADE:
+            case NodeType::COUNT:
+                break;
         }
+    }
+}
 
-        sc->nodes.push( value );
+int scene_walk_ahead( Scene* sc, int node_index, int max_count, int* out_indices ) {
+    int count = 0;
 
-skip_node:
-        at = at->next;
+    // NOTE(alicia): out_indices is also the queue, walk is breadth first
+    // so that nodes closer to node_index are found before max_count cuts it off.
+    // jumps to other scenes have index -1 and are skipped.
+    auto visit = [&]( int index ) {
+        if( index < 0 || index >= sc->node_count() || count >= max_count ) {
+            return;
+        }
+        for( int i = 0; i < count; ++i ) {
+            if( out_indices[i] == index ) {
+                return;
+            }
+        }
+        out_indices[count++] = index;
+    };
+
+    visit( node_index );
+
+    for( int head = 0; head < count; ++head ) {
+        int  index = out_indices[head];
+        Node node  = sc->node( index );
+        int  next  = index + 1;
+
+        switch( node.type ) {
+            case NodeType::CONTROL: switch( node.control->type ) {
+                case ControlType::JUMP: {
+                    visit( node.control->jump.index );
+                } break;
+                case ControlType::CONDITIONAL: {
+                    auto* c = &node.control->conditional;
+                    visit( c->if_true.index );
+                    visit( c->if_false.index );
+                } break;
+                case ControlType::COUNT:
+                    break;
+            } break;
+            case NodeType::FORK: {
+                auto* options = (ForkOption*)(sc->storage + node.fork->byte_offset);
+                for( int i = 0; i < node.fork->len; ++i ) {
+                    if( options[i].type == ForkActionType::JUMP ) {
+                        visit( options[i].jump.index );
+                    } else {
+                        visit( next );
+                    }
+                }
+            } break;
+
+            case NodeType::NONE:
+            case NodeType::STORY:
+            case NodeType::WRITE:
+            case NodeType::FADE:
+            case NodeType::COUNT: {
+                visit( next );
+            } break;
+        }
     }
 
-    free( json );
-    UnloadFileText( src.buf );
+    return count;
+}
+
+usize scene_node_bytes( const Scene* sc ) {
+    usize result = 0;
+    result += (usize)sc->types.len    * sizeof(NodeType);
+    result += (usize)sc->ids.len      * sizeof(int);
+    result += (usize)sc->payloads.len * sizeof(int);
+    result += (usize)sc->stories.len  * sizeof(StoryNode);
+    result += (usize)sc->controls.len * sizeof(ControlNode);
+    result += (usize)sc->writes.len   * sizeof(WriteNode);
+    result += (usize)sc->forks.len    * sizeof(ForkNode);
+    result += (usize)sc->fades.len    * sizeof(FadeNode);
+    result += (usize)sc->storage.len;
+    result += (usize)sc->lookup.len   * sizeof(int);
+    return result;
 }
 
 void scene_print( Scene* scene ) {
     TraceLog( LOG_INFO, "title: '%s'", scene->title.to_string( scene->string ).buf );
     TraceLog( LOG_INFO, "id:    %i", scene->id );
-    for( int i = 0; i < scene->nodes.len; ++i ) {
-        auto* node = scene->nodes + i;
+    for( int i = 0; i < scene->node_count(); ++i ) {
+        Node node = scene->node( i );
         TraceLog( LOG_INFO, "{" );
-        TraceLog( LOG_INFO, "  id:              %i", node->id );
-        TraceLog( LOG_INFO, "  type:            %s", string_from_node_type( node->type ).buf );
-        switch( node->type ) {
+        TraceLog( LOG_INFO, "  id:              %i", node.id );
+        TraceLog( LOG_INFO, "  type:            %s", string_from_node_type( node.type ).buf );
+        switch( node.type ) {
             case NodeType::STORY: {
-                TraceLog( LOG_INFO, "  text:            '%s'", node->story.text.to_string( scene->string ).buf );
-                TraceLog( LOG_INFO, "  character:       '%s'", node->story.character.to_string( scene->string ).buf );
-                TraceLog( LOG_INFO, "  animation.name:  '%s'", node->story.animation.name.to_string( scene->string ).buf );
-                TraceLog( LOG_INFO, "  animation.speed: %f", node->story.animation.speed );
-                TraceLog( LOG_INFO, "  animation.side:  %s", string_from_animation_side( node->story.animation.side ).buf );
-                TraceLog( LOG_INFO, "  animation.clear: %s", node->story.animation.clear ? "true" : "false" );
-                if( node->story.has_write ) {
-                    TraceLog( LOG_INFO, "  write.key:       '%s'", node->story.write.key.to_string( scene->string ).buf );
-                    TraceLog( LOG_INFO, "  write.value:     %i'", node->story.write.value );
+                TraceLog( LOG_INFO, "  text:            '%s'", node.story->text.to_string( scene->string ).buf );
+                TraceLog( LOG_INFO, "  character:       '%s'", node.story->character.to_string( scene->string ).buf );
+                TraceLog( LOG_INFO, "  animation:       '%s'", string_from_animation( node.story->animation.id ).buf );
+                TraceLog( LOG_INFO, "  animation.speed: %f", node.story->animation.speed );
+                TraceLog( LOG_INFO, "  animation.side:  %s", string_from_animation_side( node.story->animation.side ).buf );
+                TraceLog( LOG_INFO, "  animation.clear: %s", node.story->animation.clear ? "true" : "false" );
+                if( node.story->has_write ) {
+                    TraceLog( LOG_INFO, "  write.key:       '%s'", scene->get_key( node.story->write.key ).buf );
+                    TraceLog( LOG_INFO, "  write.value:     %i'", node.story->write.value );
                 }
             } break;
             case NodeType::CONTROL: {
-                TraceLog( LOG_INFO, "  type:            %s", string_from_control_type( node->control.type ).buf );
-                switch( node->control.type ) {
+                TraceLog( LOG_INFO, "  type:            %s", string_from_control_type( node.control->type ).buf );
+                switch( node.control->type ) {
                     case ControlType::JUMP: {
-                        TraceLog( LOG_INFO, "  scene:           %i", node->control.jump.scene );
-                        TraceLog( LOG_INFO, "  node:            %i", node->control.jump.node );
+                        TraceLog( LOG_INFO, "  scene:           %i", node.control->jump.scene );
+                        TraceLog( LOG_INFO, "  node:            %i", node.control->jump.node );
+                        TraceLog( LOG_INFO, "  index:           %i", node.control->jump.index );
                     } break;
                     case ControlType::CONDITIONAL: {
-                        TraceLog( LOG_INFO, "  key:             '%s'", node->control.conditional.key.to_string( scene->string ).buf );
-                        TraceLog( LOG_INFO, "  false:           %s", node->control.conditional.if_false.does_something ? TextFormat( "scene %i - node %i", node->control.conditional.if_false.scene, node->control.conditional.if_false.node ) : "none" );
-                        TraceLog( LOG_INFO, "  true:            %s", node->control.conditional.if_true.does_something ? TextFormat( "scene %i - node %i", node->control.conditional.if_true.scene, node->control.conditional.if_true.node ) : "none" );
+                        TraceLog( LOG_INFO, "  key:             '%s'", scene->get_key( node.control->conditional.key ).buf );
+                        TraceLog( LOG_INFO, "  false:           %s", node.control->conditional.if_false.does_something ? TextFormat( "scene %i - node %i", node.control->conditional.if_false.scene, node.control->conditional.if_false.node ) : "none" );
+                        TraceLog( LOG_INFO, "  true:            %s", node.control->conditional.if_true.does_something ? TextFormat( "scene %i - node %i", node.control->conditional.if_true.scene, node.control->conditional.if_true.node ) : "none" );
                     } break;
                     case ControlType::COUNT:
                         break;
                 }
             } break;
             case NodeType::WRITE: {
-                TraceLog( LOG_INFO, "  key:             '%s'", node->write.key.to_string( scene->string ).buf );
-                TraceLog( LOG_INFO, "  value:           %i", node->write.value );
+                TraceLog( LOG_INFO, "  key:             '%s'", scene->get_key( node.write->key ).buf );
+                TraceLog( LOG_INFO, "  value:           %i", node.write->value );
             } break;
             case NodeType::FORK: {
-                TraceLog( LOG_INFO, "  options: [%i] {", node->fork.len );
+                TraceLog( LOG_INFO, "  options: [%i] {", node.fork->len );
 
                 Slice<ForkOption> options = {
-                    node->fork.len,
-                    (ForkOption*)( scene->storage + node->fork.byte_offset ) };
+                    node.fork->len,
+                    (ForkOption*)( scene->storage + node.fork->byte_offset ) };
 
                 for( int i = 0; i < options.len; ++i ) {
                     auto* opt = options + i;
@@ -438,9 +1713,10 @@ void scene_print( Scene* scene ) {
                         case ForkActionType::JUMP: {
                             TraceLog( LOG_INFO, "      scene:  %i", opt->jump.scene );
                             TraceLog( LOG_INFO, "      node:   %i", opt->jump.node );
+                            TraceLog( LOG_INFO, "      index:  %i", opt->jump.index );
                         } break;
                         case ForkActionType::WRITE: {
-                            String key = opt->write.key.to_string( scene->string );
+                            String key = scene->get_key( opt->write.key );
                             TraceLog( LOG_INFO, "      key:   '%s'", key.buf );
                             TraceLog( LOG_INFO, "      value: %i", opt->write.value );
                         } break;
@@ -452,7 +1728,7 @@ void scene_print( Scene* scene ) {
                     TraceLog( LOG_INFO, "    }" );
                 }
 
-                TraceLog( LOG_INFO, "  }", node->fork.len );
+                TraceLog( LOG_INFO, "  }", node.fork->len );
             } break;
 
             case NodeType::FADE: {
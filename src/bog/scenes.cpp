@@ -0,0 +1,359 @@
+/**
+ * @file   scenes.cpp
+ * @brief  Scene cache.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   August 28, 2025
+*/
+#include "bog/scenes.h"
+#include "bog/scene.h"
+#include "bog/profile.h"
+#include <string.h>
+
+#define SCENE_MAX_PATH (256)
+
+struct SceneEntry {
+    int  id;
+    char path[SCENE_MAX_PATH];
+    /* index into slots, -1 if not loaded */
+    int  slot;
+};
+
+struct SceneSlot {
+    /* index into entries, -1 if slot is empty */
+    int entry;
+    int refs;
+    /* release tick, lowest is unloaded first */
+    u64 last_used;
+};
+
+struct StateScenes {
+    bool is_scanned;
+
+    /* sorted by id */
+    SceneEntry entries[SCENE_MAX_COUNT];
+    int        count;
+
+    Scene     scenes[SCENE_CACHE_COUNT];
+    SceneSlot slots[SCENE_CACHE_COUNT];
+
+    u64 tick;
+    u64 hits;
+    u64 misses;
+};
+static StateScenes __SCENES;
+
+// NOTE(alicia): json scenes are listed along with compiled scenes that
+// have no json source, scene_load picks compiled sibling of json itself.
+static bool scenes_is_listed( const char* path ) {
+    const char* name = GetFileName( path );
+    if( strcmp( name, "schema.json" ) == 0 ) {
+        return false;
+    }
+
+    if( IsFileExtension( path, SCENE_COMPILED_EXT ) ) {
+        const char* json = TextFormat(
+            "%s/%s.json", GetDirectoryPath( path ), GetFileNameWithoutExt( path ) );
+        return !FileExists( json );
+    }
+    return true;
+}
+
+static void scenes_insert( int id, const char* path ) {
+    auto* sc = &__SCENES;
+
+    if( sc->count >= SCENE_MAX_COUNT ) {
+        TraceLog( LOG_WARNING, "%s: too many scenes, scene is skipped.", path );
+        return;
+    }
+    if( strlen( path ) >= SCENE_MAX_PATH ) {
+        TraceLog( LOG_WARNING, "%s: scene path is too long, scene is skipped.", path );
+        return;
+    }
+
+    int at = sc->count;
+    while( at > 0 && sc->entries[at - 1].id > id ) {
+        at--;
+    }
+    if( at > 0 && sc->entries[at - 1].id == id ) {
+        TraceLog(
+            LOG_WARNING, "%s: scene id %i is already used by %s, scene is skipped.",
+            path, id, sc->entries[at - 1].path );
+        return;
+    }
+
+    memmove( sc->entries + at + 1, sc->entries + at, sizeof(SceneEntry) * (sc->count - at) );
+    sc->count++;
+
+    auto* entry = sc->entries + at;
+    entry->id   = id;
+    entry->slot = -1;
+    strcpy( entry->path, path );
+}
+
+void scenes_scan() {
+    auto* sc = &__SCENES;
+    if( sc->is_scanned ) {
+        return;
+    }
+    PROFILE_ZONE( "scenes_scan" );
+
+    sc->is_scanned = true;
+    sc->count      = 0;
+    for( auto& slot : sc->slots ) {
+        slot.entry = -1;
+    }
+
+    FilePathList files = LoadDirectoryFilesEx( SCENE_DIRECTORY, ".json;" SCENE_COMPILED_EXT, false );
+    for( unsigned int i = 0; i < files.count; ++i ) {
+        const char* path = files.paths[i];
+        if( !scenes_is_listed( path ) ) {
+            continue;
+        }
+
+        int id = -1;
+        if( !scene_read_id( path, &id ) ) {
+            TraceLog( LOG_WARNING, "%s: failed to read scene id, scene is skipped.", path );
+            continue;
+        }
+        if( id < 0 ) {
+            TraceLog( LOG_WARNING, "%s: scene id must not be negative, scene is skipped.", path );
+            continue;
+        }
+
+        scenes_insert( id, path );
+    }
+    UnloadDirectoryFiles( files );
+
+    TraceLog( LOG_INFO, "%s: found %i scene(s).", SCENE_DIRECTORY, sc->count );
+}
+
+static int scenes_find( int scene_id ) {
+    auto* sc = &__SCENES;
+
+    int low  = 0;
+    int high = sc->count - 1;
+    while( low <= high ) {
+        int middle = (low + high) / 2;
+        int id     = sc->entries[middle].id;
+
+        if( id == scene_id ) {
+            return middle;
+        } else if( id < scene_id ) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+int scenes_first() {
+    scenes_scan();
+    return __SCENES.count ? __SCENES.entries[0].id : -1;
+}
+int scenes_after( int scene_id ) {
+    scenes_scan();
+
+    auto* sc = &__SCENES;
+    for( int i = 0; i < sc->count; ++i ) {
+        if( sc->entries[i].id > scene_id ) {
+            return sc->entries[i].id;
+        }
+    }
+    return -1;
+}
+
+static void scenes_unload( int slot_index ) {
+    auto* sc   = &__SCENES;
+    auto* slot = sc->slots + slot_index;
+
+    if( slot->entry >= 0 ) {
+        sc->entries[slot->entry].slot = -1;
+    }
+    sc->scenes[slot_index].free();
+    sc->scenes[slot_index] = {};
+
+    slot->entry     = -1;
+    slot->refs      = 0;
+    slot->last_used = 0;
+}
+
+// NOTE(alicia): empty slot, otherwise slot of unused scene
+// that was released the longest time ago.
+static int scenes_free_slot() {
+    auto* sc = &__SCENES;
+
+    int result = -1;
+    for( int i = 0; i < SCENE_CACHE_COUNT; ++i ) {
+        const auto& slot = sc->slots[i];
+        if( slot.entry < 0 ) {
+            return i;
+        }
+        if( slot.refs ) {
+            continue;
+        }
+        if( result < 0 || slot.last_used < sc->slots[result].last_used ) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+Scene* scenes_acquire( int scene_id ) {
+    scenes_scan();
+
+    auto* sc = &__SCENES;
+
+    int entry_index = scenes_find( scene_id );
+    if( entry_index < 0 ) {
+        return nullptr;
+    }
+    auto* entry = sc->entries + entry_index;
+
+    if( entry->slot >= 0 ) {
+        sc->hits++;
+        sc->slots[entry->slot].refs++;
+        return sc->scenes + entry->slot;
+    }
+
+    int slot_index = scenes_free_slot();
+    Assert( slot_index >= 0, "scene cache is full!" );
+
+    if( sc->slots[slot_index].entry >= 0 ) {
+        TraceLog(
+            LOG_INFO, "%s: evicted from scene cache.",
+            sc->entries[sc->slots[slot_index].entry].path );
+        scenes_unload( slot_index );
+    }
+
+    sc->misses++;
+
+    auto* scene = sc->scenes + slot_index;
+    scene_load( entry->path, scene );
+
+    auto* slot  = sc->slots + slot_index;
+    slot->entry = entry_index;
+    slot->refs  = 1;
+    entry->slot = slot_index;
+
+    return scene;
+}
+void scenes_release( Scene* scene ) {
+    auto* sc = &__SCENES;
+
+    int slot_index = (int)(scene - sc->scenes);
+    Assert(
+        slot_index >= 0 && slot_index < SCENE_CACHE_COUNT,
+        "scene was not acquired from scene cache!" );
+
+    auto* slot = sc->slots + slot_index;
+    Assert( slot->refs > 0, "scene %i released more times than it was acquired!", scene->id );
+
+    slot->refs--;
+    slot->last_used = ++sc->tick;
+}
+
+static bool scenes_jump_exists( const Scene* from, int scene_id, int node_id ) {
+    if( !scene_is_other( from, scene_id ) ) {
+        return true;
+    }
+
+    Scene* to = scenes_acquire( scene_id );
+    if( !to ) {
+        return false;
+    }
+    bool result = to->index_of( node_id ) >= 0;
+    scenes_release( to );
+
+    return result;
+}
+
+int scenes_validate() {
+    PROFILE_ZONE( "scenes_validate" );
+    scenes_scan();
+
+    auto* sc = &__SCENES;
+
+    int result = 0;
+    for( int i = 0; i < sc->count; ++i ) {
+        Scene* scene = scenes_acquire( sc->entries[i].id );
+
+        auto check = [&]( const Node& node, int scene_id, int node_id ) {
+            if( !scenes_jump_exists( scene, scene_id, node_id ) ) {
+                TraceLog(
+                    LOG_ERROR, "scene %i: node %i jumps to node %i/%i which does not exist!",
+                    scene->id, node.id, scene_id, node_id );
+                result++;
+            }
+        };
+
+        for( int j = 0; j < scene->node_count(); ++j ) {
+            Node node = scene->node( j );
+            switch( node.type ) {
+                case NodeType::CONTROL: switch( node.control->type ) {
+                    case ControlType::JUMP: {
+                        check( node, node.control->jump.scene, node.control->jump.node );
+                    } break;
+                    case ControlType::CONDITIONAL: {
+                        auto* c = &node.control->conditional;
+                        if( c->if_false.does_something ) {
+                            check( node, c->if_false.scene, c->if_false.node );
+                        }
+                        if( c->if_true.does_something ) {
+                            check( node, c->if_true.scene, c->if_true.node );
+                        }
+                    } break;
+                    case ControlType::COUNT:
+                        break;
+                } break;
+                case NodeType::FORK: {
+                    auto* options = (const ForkOption*)(scene->storage + node.fork->byte_offset);
+                    for( int k = 0; k < node.fork->len; ++k ) {
+                        if( options[k].type == ForkActionType::JUMP ) {
+                            check( node, options[k].jump.scene, options[k].jump.node );
+                        }
+                    }
+                } break;
+
+                case NodeType::NONE:
+                case NodeType::STORY:
+                case NodeType::WRITE:
+                case NodeType::FADE:
+                case NodeType::COUNT:
+                    break;
+            }
+        }
+
+        scenes_release( scene );
+    }
+
+    return result;
+}
+
+SceneStats scenes_stats() {
+    auto* sc = &__SCENES;
+
+    SceneStats result = {};
+    result.count  = sc->count;
+    result.hits   = sc->hits;
+    result.misses = sc->misses;
+
+    for( const auto& slot : sc->slots ) {
+        result.loaded_count += slot.entry >= 0;
+    }
+    return result;
+}
+
+void scenes_shutdown() {
+    auto* sc = &__SCENES;
+    if( sc->is_scanned ) {
+        for( int i = 0; i < SCENE_CACHE_COUNT; ++i ) {
+            if( sc->slots[i].entry >= 0 ) {
+                scenes_unload( i );
+            }
+        }
+    }
+
+    sc->is_scanned = false;
+    sc->count      = 0;
+}
@@ -7,232 +7,83 @@
 #include "bog/state.h"
 #include "bog/collections.h" // IWYU pragma: keep
 #include "bog/ui.h"
+#include "bog/fonts.h"
+#include "bog/replay.h"
 
 #include "bog/scene.h"
+#include "bog/scenes.h"
+#include "bog/profile.h"
 
 #define MIN_HEIGHT (100.0f)
 
 void draw_scene_title( Font font, const char* scene_name, float percent );
+void _game_bind_scene_keys( GameState* s );
+
+Node _game_current_node( GameState* s );
+int _game_step_begin(
+    State* state, const GameInput* input, Node node, bool scene_transition_finished );
+int _game_step_choice( GameState* s, Node node, int selected, int target_node );
+void _game_step_end( State* state, const GameInput* input, Node node, int target_node );
+void _game_prefetch( GameState* s );
+int _game_jump( GameState* s, int scene_id, int node_id, int index );
+void _game_change_scene( GameState* s, int scene_id, int node_id );
 
 void _game_update( State* state ) {
     auto* s     = &state->game;
-    auto* scene = &s->scene;
+    auto* scene = s->scene;
 
     float volume_music = state->common.settings.volume * state->common.settings.music;
     float volume_sfx   = state->common.settings.volume * state->common.settings.sfx;
     (void)volume_sfx;
 
-    float   dt     = GetFrameTime();
-    Vector2 mouse  = GetMousePosition();
+    Vector2 mouse  = input_mouse_position();
     Vector2 screen = { (float)GetScreenWidth(), (float)GetScreenHeight() };
 
-    bool left_pressed, left_down;
-    left_pressed = left_down = false;
+    GameInput input = {};
+    input.dt     = input_frame_time();
+    input.choice = -1;
 
+    bool left_pressed = false;
     if( !s->is_paused ) {
-        left_pressed = IsMouseButtonPressed( MOUSE_BUTTON_LEFT );
-        left_down    = IsMouseButtonDown( MOUSE_BUTTON_LEFT );
-    }
-
-    bool on_scene_change = s->scene_id != scene->id;
-    bool on_node_change  = s->node_id  != scene->current_node;
-
-    bool scene_transition_finished = s->scene_change_timer >= SCENE_TRANSITION_TIME;
-
-    int target_node = scene->current_node;
+        left_pressed = input_mouse_pressed( MOUSE_BUTTON_LEFT );
 
-    Node* node = nullptr;
-
-    if( s->is_paused ) {
-        text_set_display_speed( TEXT_SPEED );
-    } else {
-        node = scene->get_current();
-        if( left_down ) {
-            text_set_display_speed( TEXT_SPEED_FAST );
-        } else {
-            text_set_display_speed( TEXT_SPEED );
-        }
+        input.fast_text = input_mouse_down( MOUSE_BUTTON_LEFT );
+        input.advance   = left_pressed && CheckCollisionPointRec( mouse, s->text_box );
     }
+    input.reveal_text = input_mouse_pressed( MOUSE_BUTTON_RIGHT );
 
-    if( node ) switch( node->type ) {
-        case NodeType::STORY: {
-            auto* story = &node->story;
-
-            if( on_node_change ) {
-                s->display_text = {};
-
-                s->text = story->text.to_string( scene->string );
-
-                if( story->character.len ) {
-                    s->character_name = story->character.to_string( scene->string );
-                } else {
-                    s->character_name = {};
-                }
-
-                if( story->animation.clear ) {
-                    s->character_name    = {};
-                    s->current_character = -1;
-                    for( size_t i = 0; i < ARRAY_LEN(s->characters); ++i ) {
-                        s->characters[i].is_enabled = false;
-                    }
-                }
-            }
-            if( on_scene_change ) {
-                s->scene_change_timer = 0.0f;
-            }
-
-            if(
-                scene_transition_finished && (
-                    (
-                        s->display_text.is_complete( s->text ) &&
-                        CheckCollisionPointRec( mouse, s->text_box ) &&
-                        left_pressed
-                    ) ||
-                    ( !s->text.len )
-                )
-            ) {
-                target_node = scene_jump_calculate_next( scene );
-            }
-
-            String animation_name = story->animation.name.to_string( scene->string );
-            switch( story->animation.side ) {
-                case AnimationSide::LEFT: {
-                    s->current_character = 0;
-                } break;
-                case AnimationSide::CENTER: {
-                    s->current_character = 1;
-                } break;
-                case AnimationSide::RIGHT: {
-                    s->current_character = 2;
-                } break;
-
-                case AnimationSide::KEEP:
-                case AnimationSide::COUNT:
-                    break;
-            }
-
-            if( animation_name.len ) {
-                int animation_id = -1;
-                if( animation_from_string( animation_name, &animation_id ) ) {
-                    s->characters[s->current_character].is_enabled = true;
-                    s->characters[s->current_character].anim.set_once( animation_id );
-                }
-            }
-        } break;
-        case NodeType::CONTROL: switch( node->control.type ) {
-            case ControlType::JUMP: {
-                auto* c = &node->control.jump;
-
-                // TODO(alicia): jump to other scene/node
-                target_node = c->node;
-                TraceLog(
-                    LOG_INFO, "Jump to %i/%i",
-                    c->scene, c->node );
-            } break;
-            case ControlType::CONDITIONAL: {
-                auto* c = &node->control.conditional;
-
-                String key = c->key.to_string( scene->string );
-
-                ConditionalJump* obj = nullptr;
-
-                bool is_true = s->kv.read( key ) != 0;
-                if( is_true ) {
-                    obj = &c->if_true;
-                } else {
-                    obj = &c->if_false;
-                }
-
-                if( obj->does_something ) {
-                    // TODO(alicia): jump to other scene/node
-                    target_node = obj->node;
-                    TraceLog(
-                        LOG_INFO,
-                        "%s = %s: Jump to %i/%i",
-                        key.buf, is_true ? "true" : "false", obj->scene, obj->node );
-                } else {
-                    target_node = scene_jump_calculate_next( scene );
-                    TraceLog(
-                        LOG_INFO,
-                        "%s = %s: Jump to %i/%i",
-                        key.buf, is_true ? "true" : "false", -1, target_node );
-                }
-            } break;
-            case ControlType::COUNT:
-                break;
-        } break;
-        case NodeType::WRITE: {
-            auto* w = &node->write;
-
-            String key = w->key.to_string( scene->string );
-            s->kv.write( key, w->value );
-
-            TraceLog( LOG_INFO, "Wrote %i to '%s'", w->value, key.buf );
-
-            target_node = scene_jump_calculate_next( scene );
-        } break;
-        case NodeType::FORK: {
-            auto* f = &node->fork;
-            
-            if( on_node_change ) {
-                Slice<ForkOption> options = {
-                    f->len, (ForkOption*)(scene->storage + f->byte_offset)
-                };
-
-                for( int i = 0; i < options.len; ++i ) {
-                    String text = options[i].text.to_string( scene->string );
-
-                    s->buttons.push( text );
-                }
-            }
-        } break;
-
-        case NodeType::FADE: {
-            if( on_node_change ) {
-                s->fade_is_reverse = node->fade.reverse;
+    float dt = input.dt;
 
-                if( s->fade_is_reverse ) {
-                    s->fade_timer = FADE_TIME;
-                } else {
-                    s->fade_timer = 0.0f;
-                }
-                TraceLog( LOG_INFO, "begin fade" );
-            }
+    bool scene_transition_finished = s->scene_change_timer >= SCENE_TRANSITION_TIME;
 
-            bool fade_complete = false;
-            if( s->fade_is_reverse ) {
-                fade_complete = s->fade_timer <= 0.0f;
-            } else {
-                fade_complete = s->fade_timer >= FADE_TIME;
-            }
+    Node node        = _game_current_node( s );
+    int  target_node = _game_step_begin( state, &input, node, scene_transition_finished );
 
-            if( fade_complete ) {
-                target_node = scene_jump_calculate_next( scene );
-                TraceLog( LOG_INFO, "end fade" );
-            }
-        } break;
-        case NodeType::NONE:
-        case NodeType::COUNT: {
-            target_node = scene_jump_calculate_next( scene );
-        } break;
-    }
+    _game_prefetch( s );
 
     // NOTE(alicia): draw -------------------------------------------
+    PROFILE_BEGIN( "game draw" );
+
     BeginDrawing();
     ClearBackground( Color{27, 27, 27, 255} );
 
     if( s->current_music >= 0 ) {
-        UpdateMusicStream( s->music[s->current_music] );
+        PROFILE_ZONE( "UpdateMusicStream" );
+        UpdateMusicStream( *s->music[s->current_music] );
     }
 
     auto& font     = state->common.font;
-    auto& tex_menu = s->textures[TEX_MENU];
+    auto& atlas    = s->atlas;
+    auto  tex_menu = atlas.texture( TEX_MENU );
 
-    auto& tex_background = s->textures[TEX_BG1 + s->kv.read( "bg" )];
+    Sprite background = {};
+    int    bg         = s->kv.read( s->key.bg );
+    if( bg >= 0 && bg < BACKGROUND_COUNT ) {
+        background = atlas.sprite( TEX_BG1 + bg );
+    }
 
     DrawTexturePro(
-        tex_background,
-        { 0, 0, (float)tex_background.width, (float)tex_background.height },
+        background.texture, background.src,
         { 0, 0, screen.x, screen.y }, {}, 0.0f, WHITE );
 
     float text_box_y, text_box_height;
@@ -240,18 +91,17 @@ void _game_update( State* state ) {
     text_box_height = (font.baseSize * 6.0f);
     text_box_y      = (screen.y - text_box_height) - 60.0f;
 
-    auto draw_character = [dt,screen]( int side, bool is_current, Color& tint, AnimationTimeline& timeline, Texture* textures ) -> Rectangle {
+    auto draw_character = [dt,screen]( int side, bool is_current, Color& tint, AnimationTimeline& timeline, const TextureAtlas& atlas ) -> Rectangle {
         Color target_tint = is_current ? WHITE : COLOR_CHARACTER_DIM;
         tint = ColorLerp( tint, target_tint, dt * 10.0f );
 
-        auto frame = timeline.update( dt );
-
-        auto& tex = textures[frame.texture];
+        auto frame  = timeline.update( dt );
+        auto sprite = atlas.sprite( frame );
 
         Rectangle src, dst;
         src = dst = {};
 
-        src = frame.src;
+        src = sprite.src;
 
         *(Vector2*)&dst.width = *(Vector2*)&src.width * 4.0f;
         dst.y = screen.y - dst.height;
@@ -271,7 +121,7 @@ void _game_update( State* state ) {
             } break;
         }
 
-        DrawTexturePro( tex, src, dst, {}, 0.0f, tint );
+        DrawTexturePro( sprite.texture, src, dst, {}, 0.0f, tint );
 
         return dst;
     };
@@ -282,7 +132,7 @@ void _game_update( State* state ) {
             s->current_character == 0,
             s->char_left.tint,
             s->char_left.anim,
-            s->textures );
+            atlas );
     }
 
     if( s->char_center.is_enabled ) {
@@ -291,7 +141,7 @@ void _game_update( State* state ) {
             s->current_character == 1,
             s->char_center.tint,
             s->char_center.anim,
-            s->textures );
+            atlas );
     }
 
     if( s->char_right.is_enabled ) {
@@ -300,7 +150,7 @@ void _game_update( State* state ) {
             s->current_character == 2,
             s->char_right.tint,
             s->char_right.anim,
-            s->textures );
+            atlas );
     }
 
     float fade_time = s->fade_timer;
@@ -316,7 +166,7 @@ void _game_update( State* state ) {
 
     DrawRectangleRec( { 0.0f, 0.0f, screen.x, screen.y }, color );
 
-    Rectangle text_area = text_box_draw( tex_menu, text_box_y, text_box_height, &s->text_box );
+    Rectangle text_area = text_box_draw( &atlas, text_box_y, text_box_height, &s->text_box );
 
     if( scene_transition_finished ) {
 
@@ -336,7 +186,7 @@ void _game_update( State* state ) {
             text_draw( font, s->character_name, position );
         }
 
-        if( IsMouseButtonPressed( MOUSE_BUTTON_RIGHT ) ) {
+        if( input.reveal_text ) {
             s->display_text.len = s->text.len;
         }
 
@@ -346,18 +196,18 @@ void _game_update( State* state ) {
             &text_area, &s->display_text, s->is_paused ? 0.0f : dt );
     }
 
-    Rectangle src_decoration = COORD_DECORATION;
+    Sprite    decoration     = atlas.sprite( TEX_MENU, COORD_DECORATION );
     Rectangle dst_decoration = { 10, 10 };
-    *(Vector2*)&dst_decoration.width = *(Vector2*)&src_decoration.width * 2.0f;
+    *(Vector2*)&dst_decoration.width = *(Vector2*)&decoration.src.width * 2.0f;
 
-    DrawTexturePro( tex_menu, src_decoration, dst_decoration, {}, 0.0f, WHITE );
+    DrawTexturePro( decoration.texture, decoration.src, dst_decoration, {}, 0.0f, WHITE );
 
     dst_decoration.x     = (screen.x - dst_decoration.width) - dst_decoration.x;
-    src_decoration.width = -src_decoration.width;
+    decoration.src.width = -decoration.src.width;
 
-    DrawTexturePro( tex_menu, src_decoration, dst_decoration, {}, 0.0f, WHITE );
+    DrawTexturePro( decoration.texture, decoration.src, dst_decoration, {}, 0.0f, WHITE );
 
-    if( node ) switch( node->type ) {
+    if( !node.is_empty() ) switch( node.type ) {
         case NodeType::STORY: {
             if( s->display_text.is_complete( s->text ) ) {
                 float t = sin( s->elapsed * 8.0f );
@@ -377,51 +227,14 @@ void _game_update( State* state ) {
                 dst.x = (text_area.x + text_area.width)  - dst.width;
                 dst.y = (text_area.y + text_area.height) - dst.height;
 
-                DrawTexturePro( tex_menu, src, dst, {}, 0.0f, tint );
+                DrawTexturePro( tex_menu, atlas.src( TEX_MENU, src ), dst, {}, 0.0f, tint );
             }
         } break;
         case NodeType::FORK: if( scene_transition_finished ) {
-            auto* f = &node->fork;
-
             int selected = s->buttons.update_and_draw(
-                font, s->textures, screen, mouse, left_pressed, dt );
-
-            bool advance_to_next_node = false;
-
-            if( selected >= 0 ) {
-                advance_to_next_node = true;
-
-                s->buttons.reset();
-
-                Slice<ForkOption> options = {
-                    f->len, (ForkOption*)(scene->storage + f->byte_offset)
-                };
-
-                ForkOption* option = options.buf + selected;
-
-                switch( option->type ) {
-                    case ForkActionType::JUMP  : {
-                        // TODO(alicia): jump
-                        target_node = option->jump.node;
-
-                        advance_to_next_node = false;
-                    } break;
-                    case ForkActionType::WRITE : {
-                        String key = option->write.key.to_string( scene->string );
-
-                        s->kv.write( key, option->write.value );
-                    } break;
-
-                    case ForkActionType::NONE  :
-                    case ForkActionType::COUNT :
-                        break;
-                }
-
-            }
+                font, &s->atlas, screen, mouse, left_pressed, dt );
 
-            if( advance_to_next_node ) {
-                target_node = scene_jump_calculate_next( scene );
-            }
+            target_node = _game_step_choice( s, node, selected, target_node );
         } break;
 
         case NodeType::FADE: {
@@ -447,12 +260,12 @@ void _game_update( State* state ) {
             if( CheckCollisionPointRec( mouse, dst ) ) {
                 tint = WHITE;
 
-                if( IsMouseButtonPressed( MOUSE_BUTTON_LEFT ) ) {
+                if( input_mouse_pressed( MOUSE_BUTTON_LEFT ) ) {
                     s->is_paused = true;
                 }
             }
 
-            DrawTexturePro( tex_menu, src, dst, {}, 0.0f, tint );
+            DrawTexturePro( tex_menu, atlas.src( TEX_MENU, src ), dst, {}, 0.0f, tint );
         } else {
             String title = scene->title.to_string( scene->string );
             if( title.buf ) {
@@ -476,7 +289,7 @@ void _game_update( State* state ) {
         dst.x = (screen.x / 2.0f) - (dst.width);
         dst.y = (screen.y / 2.0f) - (dst.height / 2.0f);
 
-        DrawTexturePro( tex_menu, src, dst, {}, 0.0f, WHITE );
+        DrawTexturePro( tex_menu, atlas.src( TEX_MENU, src ), dst, {}, 0.0f, WHITE );
 
         Rectangle act_src, act_dst;
 
@@ -484,7 +297,7 @@ void _game_update( State* state ) {
         act_dst = dst;
 
         act_src = COORD_PAUSE_ACT;
-        int which_act = s->kv.read( "act" );
+        int which_act = s->kv.read( s->key.act );
         act_src.y += act_src.height * which_act;
 
         *(Vector2*)&act_dst.width = *(Vector2*)&act_src.width * 2.0f;
@@ -492,18 +305,17 @@ void _game_update( State* state ) {
         act_dst.x +=  94.0f;
         act_dst.y  = ((dst.y + dst.height) - act_dst.height) - 12.0f;
 
-        DrawTexturePro( tex_menu, act_src, act_dst, {}, 0.0f, WHITE );
+        DrawTexturePro( tex_menu, atlas.src( TEX_MENU, act_src ), act_dst, {}, 0.0f, WHITE );
 
         auto draw_button = [s,dt]( float x, float y, int which, float size = 2.0f ) -> Rectangle {
-            auto  src = s->anim[which].update( dt );
-            auto& tex = s->textures[src.texture];
+            auto sprite = s->atlas.sprite( s->anim[which].update( dt ) );
 
             Rectangle dst = {};
             dst.x = x;
             dst.y = y;
-            *(Vector2*)&dst.width = (*(Vector2*)&src.src.width) * size;
+            *(Vector2*)&dst.width = (*(Vector2*)&sprite.src.width) * size;
 
-            DrawTexturePro( tex, src.src, dst, {}, 0.0f, WHITE );
+            DrawTexturePro( sprite.texture, sprite.src, dst, {}, 0.0f, WHITE );
 
             return dst;
         };
@@ -524,7 +336,7 @@ void _game_update( State* state ) {
             if( CheckCollisionPointRec( mouse, rect ) && !s->is_settings_open ) {
                 s->anim[i].set_once( ANIM_BUTTON_PLAY_SELECT + (i * 2) );
 
-                if( IsMouseButtonPressed( MOUSE_BUTTON_LEFT ) ) {
+                if( input_mouse_pressed( MOUSE_BUTTON_LEFT ) ) {
                     switch( i ) {
                         // resume
                         case 0: {
@@ -555,54 +367,504 @@ void _game_update( State* state ) {
         draw_settings( &state->common.settings, state->common.font, &s->is_settings_open );
     }
 
-    int new_music = s->kv.read( "music" );
-    if( s->current_music != new_music ) {
+    // NOTE(alicia): music may still be loading, switch once it is.
+    int new_music = s->kv.read( s->key.music );
+    if(
+        s->current_music != new_music &&
+        new_music >= 0 && new_music < MUS_COUNT &&
+        s->music[new_music] && asset_music_is_ready( s->music[new_music] )
+    ) {
         if( s->current_music >= 0 ) {
-            StopMusicStream( s->music[s->current_music] );
+            StopMusicStream( *s->music[s->current_music] );
         }
 
         s->current_music = new_music;
         TraceLog( LOG_INFO, "Switched to music: %s", __MUSIC_PATHS[new_music] );
 
-        PlayMusicStream( s->music[s->current_music] );
+        PlayMusicStream( *s->music[s->current_music] );
     }
     if( s->last_music_volume != volume_music ) {
         if( s->current_music >= 0 ) {
-            SetMusicVolume( s->music[s->current_music], volume_music );
+            SetMusicVolume( *s->music[s->current_music], volume_music );
         }
     }
 
+    LoaderProgress progress = loader_progress();
+    if( !progress.is_complete() ) {
+        Rectangle bar = { 0.0f, screen.y - 4.0f, screen.x * progress.fraction(), 4.0f };
+        DrawRectangleRec( bar, COLOR_CHARACTER_DIM );
+    }
+
+    PROFILE_BEGIN( "EndDrawing" );
     EndDrawing();
+    PROFILE_END();
+
+    PROFILE_END();
+
+    _game_step_end( state, &input, node, target_node );
+}
+
+void _game_update_headless( State* state ) {
+    auto* s     = &state->game;
+    auto* input = &state->common.input;
+
+    bool scene_transition_finished = s->scene_change_timer >= SCENE_TRANSITION_TIME;
+
+    Node node        = _game_current_node( s );
+    int  target_node = _game_step_begin( state, input, node, scene_transition_finished );
+
+    // NOTE(alicia): mirrors what drawing does to game state.
+    if( scene_transition_finished ) {
+        if( input->reveal_text ) {
+            s->display_text.len = s->text.len;
+        }
+        if( s->text.len ) {
+            text_display_update( &s->display_text, s->is_paused ? 0.0f : input->dt );
+        }
+
+        if( !node.is_empty() && node.type == NodeType::FORK ) {
+            int selected = input->choice < node.fork->len ? input->choice : -1;
+            target_node  = _game_step_choice( s, node, selected, target_node );
+        }
+    }
+
+    _game_step_end( state, input, node, target_node );
+}
+
+// NOTE(alicia): assets that nodes a little ahead of current node
+// could need are queued on the loader before they are reached.
+// every branch is followed since there is no telling which one is taken.
+// on demand textures and music that nothing ahead needs
+// are handed back to asset cache.
+void _game_prefetch_wanted( GameState* s, u32* out_textures, u32* out_music ) {
+    auto* scene = s->scene;
+
+    static_assert( TEX_COUNT <= 32, "wanted textures must fit in u32!" );
+    static_assert( MUS_COUNT <= 32, "wanted music must fit in u32!" );
+
+    u32 wanted_textures = 0;
+    u32 wanted_music    = 0;
+
+    auto want_animation = [&wanted_textures]( int animation ) {
+        if( animation == ANIM_NONE ) {
+            return;
+        }
+        const auto& anim = animation_get( animation );
+        for( int i = 0; i < anim.frame_count; ++i ) {
+            wanted_textures |= 1u << anim.frames[i].texture;
+        }
+    };
+    auto want_write = [&]( int kv_key, int value ) {
+        if( kv_key == s->key.bg ) {
+            if( value >= 0 && value < BACKGROUND_COUNT ) {
+                wanted_textures |= 1u << (TEX_BG1 + value);
+            }
+        } else if( kv_key == s->key.music ) {
+            if( value >= 0 && value < MUS_COUNT ) {
+                wanted_music |= 1u << value;
+            }
+        }
+    };
 
-    // NOTE(alicia): post -------------------------------------------
+    want_write( s->key.bg, s->kv.read( s->key.bg ) );
+    want_write( s->key.music, s->kv.read( s->key.music ) );
+    if( s->current_music >= 0 ) {
+        wanted_music |= 1u << s->current_music;
+    }
+    for( const auto& character : s->characters ) {
+        if( character.is_enabled ) {
+            want_animation( character.anim.animation );
+        }
+    }
 
-    s->scene_id = scene->id;
-    s->node_id  = scene->current_node;
+    int indices[PREFETCH_LOOKAHEAD_NODES];
+    int count = scene_walk_ahead(
+        scene, scene->current, PREFETCH_LOOKAHEAD_NODES, indices );
+
+    for( int i = 0; i < count; ++i ) {
+        Node node = scene->node( indices[i] );
+        switch( node.type ) {
+            case NodeType::STORY: {
+                auto* story = node.story;
+                want_animation( story->animation.id );
+                if( story->has_write ) {
+                    want_write( s->scene_keys[story->write.key], story->write.value );
+                }
+            } break;
+            case NodeType::WRITE: {
+                want_write( s->scene_keys[node.write->key], node.write->value );
+            } break;
+            case NodeType::FORK: {
+                auto* options = (ForkOption*)(scene->storage + node.fork->byte_offset);
+                for( int j = 0; j < node.fork->len; ++j ) {
+                    auto* option = options + j;
+                    if( option->type == ForkActionType::WRITE ) {
+                        want_write( s->scene_keys[option->write.key], option->write.value );
+                    }
+                }
+            } break;
+
+            case NodeType::NONE:
+            case NodeType::CONTROL:
+            case NodeType::FADE:
+            case NodeType::COUNT:
+                break;
+        }
+    }
+
+    *out_textures = wanted_textures;
+    *out_music    = wanted_music;
+}
+void _game_prefetch( GameState* s ) {
+    if( s->prefetch_index == s->scene->current ) {
+        return;
+    }
+    s->prefetch_index = s->scene->current;
+
+    PROFILE_ZONE( "game prefetch" );
+
+    u32 wanted_textures = 0;
+    u32 wanted_music    = 0;
+    _game_prefetch_wanted( s, &wanted_textures, &wanted_music );
+
+    for( int texture = 0; texture < TEX_COUNT; ++texture ) {
+        if( wanted_textures & (1u << texture) ) {
+            atlas_require( &s->atlas, texture );
+        } else {
+            atlas_release( &s->atlas, texture );
+        }
+    }
+
+    for( int i = 0; i < MUS_COUNT; ++i ) {
+        if( wanted_music & (1u << i) ) {
+            if( !s->music[i] ) {
+                s->music[i] = asset_music_acquire( __MUSIC_PATHS[i] );
+            }
+        } else if( s->music[i] ) {
+            asset_music_release( s->music[i] );
+            s->music[i] = nullptr;
+        }
+    }
+}
+
+Node _game_current_node( GameState* s ) {
+    if( s->is_paused ) {
+        Node result  = {};
+        result.index = -1;
+        return result;
+    }
+    return s->scene->get_current();
+}
+
+// NOTE(alicia): scene graph logic is split around drawing
+// so that headless updates can run it without drawing anything.
+// returns index of node to move to at the end of frame.
+int _game_step_begin(
+    State* state, const GameInput* input, Node node, bool scene_transition_finished
+) {
+    PROFILE_ZONE( "game logic" );
+
+    auto* s     = &state->game;
+    auto* scene = s->scene;
+
+    bool on_scene_change = s->scene_id != scene->id;
+    bool on_node_change  = on_scene_change || s->node_index != scene->current;
+
+    int target_node = scene->current;
+    s->target_scene = -1;
+
+    if( !s->is_paused && input->fast_text ) {
+        text_set_display_speed( TEXT_SPEED_FAST );
+    } else {
+        text_set_display_speed( TEXT_SPEED );
+    }
+
+    if( !node.is_empty() ) switch( node.type ) {
+        case NodeType::STORY: {
+            auto* story = node.story;
+
+            if( on_node_change ) {
+                s->display_text = {};
+
+                s->text = story->text.to_string( scene->string );
+
+                if( story->character.len ) {
+                    s->character_name = story->character.to_string( scene->string );
+                } else {
+                    s->character_name = {};
+                }
+
+                if( story->animation.clear ) {
+                    s->character_name    = {};
+                    s->current_character = -1;
+                    for( size_t i = 0; i < ARRAY_LEN(s->characters); ++i ) {
+                        s->characters[i].is_enabled = false;
+                    }
+                }
+            }
+            if( on_scene_change ) {
+                s->scene_change_timer = 0.0f;
+            }
+
+            if(
+                scene_transition_finished && (
+                    ( s->display_text.is_complete( s->text ) && input->advance ) ||
+                    ( !s->text.len )
+                )
+            ) {
+                target_node = scene_jump_calculate_next( scene );
+            }
+
+            switch( story->animation.side ) {
+                case AnimationSide::LEFT: {
+                    s->current_character = 0;
+                } break;
+                case AnimationSide::CENTER: {
+                    s->current_character = 1;
+                } break;
+                case AnimationSide::RIGHT: {
+                    s->current_character = 2;
+                } break;
+
+                case AnimationSide::KEEP:
+                case AnimationSide::COUNT:
+                    break;
+            }
+
+            if( story->animation.id != ANIM_NONE ) {
+                s->characters[s->current_character].is_enabled = true;
+                s->characters[s->current_character].anim.set_once( story->animation.id );
+            }
+        } break;
+        case NodeType::CONTROL: switch( node.control->type ) {
+            case ControlType::JUMP: {
+                auto* c = &node.control->jump;
+
+                target_node = _game_jump( s, c->scene, c->node, c->index );
+                TraceLog(
+                    LOG_INFO, "Jump to %i/%i",
+                    c->scene, c->node );
+            } break;
+            case ControlType::CONDITIONAL: {
+                auto* c = &node.control->conditional;
+
+                String key = scene->get_key( c->key );
+
+                ConditionalJump* obj = nullptr;
+
+                bool is_true = s->kv.read( s->scene_keys[c->key] ) != 0;
+                if( is_true ) {
+                    obj = &c->if_true;
+                } else {
+                    obj = &c->if_false;
+                }
+
+                // NOTE(alicia): jump that does nothing is linked to next node.
+                if( obj->does_something ) {
+                    target_node = _game_jump( s, obj->scene, obj->node, obj->index );
+                    TraceLog(
+                        LOG_INFO,
+                        "%s = %s: Jump to %i/%i",
+                        key.buf, is_true ? "true" : "false", obj->scene, obj->node );
+                } else {
+                    target_node = obj->index;
+                    TraceLog(
+                        LOG_INFO,
+                        "%s = %s: Jump to %i/%i",
+                        key.buf, is_true ? "true" : "false", -1,
+                        target_node >= 0 ? scene->ids[target_node] : -1 );
+                }
+            } break;
+            case ControlType::COUNT:
+                break;
+        } break;
+        case NodeType::WRITE: {
+            auto* w = node.write;
+
+            String key = scene->get_key( w->key );
+            s->kv.write( s->scene_keys[w->key], w->value );
+
+            TraceLog( LOG_INFO, "Wrote %i to '%s'", w->value, key.buf );
+
+            target_node = scene_jump_calculate_next( scene );
+        } break;
+        case NodeType::FORK: {
+            auto* f = node.fork;
+            
+            if( on_node_change ) {
+                Slice<ForkOption> options = {
+                    f->len, (ForkOption*)(scene->storage + f->byte_offset)
+                };
+
+                for( int i = 0; i < options.len; ++i ) {
+                    String text = options[i].text.to_string( scene->string );
+
+                    s->buttons.push( text );
+                }
+            }
+        } break;
+
+        case NodeType::FADE: {
+            if( on_node_change ) {
+                s->fade_is_reverse = node.fade->reverse;
+
+                if( s->fade_is_reverse ) {
+                    s->fade_timer = FADE_TIME;
+                } else {
+                    s->fade_timer = 0.0f;
+                }
+                TraceLog( LOG_INFO, "begin fade" );
+            }
+
+            bool fade_complete = false;
+            if( s->fade_is_reverse ) {
+                fade_complete = s->fade_timer <= 0.0f;
+            } else {
+                fade_complete = s->fade_timer >= FADE_TIME;
+            }
+
+            if( fade_complete ) {
+                target_node = scene_jump_calculate_next( scene );
+                TraceLog( LOG_INFO, "end fade" );
+            }
+        } break;
+        case NodeType::NONE:
+        case NodeType::COUNT: {
+            target_node = scene_jump_calculate_next( scene );
+        } break;
+    }
+
+    return target_node;
+}
+int _game_step_choice( GameState* s, Node node, int selected, int target_node ) {
+    PROFILE_ZONE( "game logic choice" );
+
+    auto* scene = s->scene;
+    auto* f     = node.fork;
+
+    bool advance_to_next_node = false;
+
+    if( selected >= 0 ) {
+        advance_to_next_node = true;
+
+        s->buttons.reset();
+
+        Slice<ForkOption> options = {
+            f->len, (ForkOption*)(scene->storage + f->byte_offset)
+        };
+
+        ForkOption* option = options.buf + selected;
+
+        switch( option->type ) {
+            case ForkActionType::JUMP  : {
+                target_node = _game_jump(
+                    s, option->jump.scene, option->jump.node, option->jump.index );
+
+                advance_to_next_node = false;
+            } break;
+            case ForkActionType::WRITE : {
+                s->kv.write( s->scene_keys[option->write.key], option->write.value );
+            } break;
+
+            case ForkActionType::NONE  :
+            case ForkActionType::COUNT :
+                break;
+        }
+    }
+
+    if( advance_to_next_node ) {
+        target_node = scene_jump_calculate_next( scene );
+    }
+
+    return target_node;
+}
+void _game_step_end( State* state, const GameInput* input, Node node, int target_node ) {
+    PROFILE_ZONE( "game logic end" );
+
+    auto* s     = &state->game;
+    auto* scene = s->scene;
+
+    float dt = input->dt;
+
+    s->scene_id   = scene->id;
+    s->node_index = scene->current;
 
     if( !s->is_paused ) {
         s->elapsed            += dt;
         s->scene_change_timer += dt;
-        scene->current_node = target_node;
+        scene->current         = target_node;
 
-        if( node && node->type == NodeType::FADE ) {
+        if( !node.is_empty() && node.type == NodeType::FADE ) {
             if( s->fade_is_reverse ) {
                 s->fade_timer -= dt;
             } else {
                 s->fade_timer += dt;
             }
         }
+
+        // NOTE(alicia): end of a scene moves on to the next scene, if there is one.
+        if( scene_is_other( scene, s->target_scene ) ) {
+            _game_change_scene( s, s->target_scene, s->target_scene_node );
+        } else if( target_node < 0 ) {
+            int next_scene = scenes_after( scene->id );
+            if( next_scene >= 0 ) {
+                _game_change_scene( s, next_scene, -1 );
+            }
+        }
     }
 
-    if( s->kv.read( "one-playthrough" ) ) {
+    if( s->kv.read( s->key.one_playthrough ) ) {
         state->common.game_finished_once = true;
     }
 
-    if( !s->kv.read( "start-game" ) || s->kv.read( "game-finished" ) ) {
+    if( !s->kv.read( s->key.start_game ) || s->kv.read( s->key.game_finished ) ) {
         state->type = StateType::MAIN_MENU;
     }
 
 }
 
+// NOTE(alicia): jumps within scene go straight to linked node index.
+// jumps to another scene stay on current node until _game_step_end
+// switches scenes, node in other scene is only looked up then.
+int _game_jump( GameState* s, int scene_id, int node_id, int index ) {
+    if( scene_is_other( s->scene, scene_id ) ) {
+        s->target_scene      = scene_id;
+        s->target_scene_node = node_id;
+        return s->scene->current;
+    }
+    return index;
+}
+
+// NOTE(alicia): node_id < 0 starts from first node of scene.
+void _game_change_scene( GameState* s, int scene_id, int node_id ) {
+    PROFILE_ZONE( "game change scene" );
+
+    Scene* next = scenes_acquire( scene_id );
+    if( !next ) {
+        TraceLog( LOG_WARNING, "Jump to %i/%i: scene does not exist!", scene_id, node_id );
+        s->scene->current = -1;
+        return;
+    }
+
+    scenes_release( s->scene );
+    s->scene = next;
+
+    int index = next->node_count() ? 0 : -1;
+    if( node_id >= 0 ) {
+        index = next->index_of( node_id );
+        if( index < 0 ) {
+            TraceLog( LOG_WARNING, "Jump to %i/%i: node does not exist!", scene_id, node_id );
+        }
+    }
+    next->current = index;
+
+    s->target_scene   = -1;
+    s->prefetch_index = -1;
+    _game_bind_scene_keys( s );
+
+    TraceLog( LOG_INFO, "Switched to scene %i/%i", scene_id, next->current_id() );
+}
+
 void draw_scene_title( Font font, const char* scene_name, float percent ) {
     Rectangle screen_rect = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
 
@@ -619,6 +881,7 @@ void draw_scene_title( Font font, const char* scene_name, float percent ) {
 
     DrawRectangleRec(screen_rect, background);
 
+    font = font_cache_require( font, String( scene_name ) );
     Vector2 text_size = MeasureTextEx( font, scene_name, font.baseSize, 1.0f );
 
     Vector2 text_position;
@@ -642,8 +905,11 @@ void _game_load( State* state ) {
 
     s->elapsed = 0.0f;
 
-    s->scene_id = -1;
-    s->node_id  = -1;
+    s->scene_id     = -1;
+    s->node_index   = -1;
+    s->target_scene = -1;
+
+    s->prefetch_index = -1;
 
     s->anim_button_play.speed     =
     s->anim_button_settings.speed =
@@ -655,39 +921,60 @@ void _game_load( State* state ) {
     s->anim_button_credits.set( ANIM_BUTTON_CREDITS_SELECT );
     s->anim_button_quit.set( ANIM_BUTTON_QUIT_SELECT );
 
-    // TODO(alicia): enumerate scenes and load first scene found.
-    scene_load( "resources/scenes/scene-01.json", &s->scene );
+    s->scene = scenes_acquire( scenes_first() );
+    Assert( s->scene, "no scenes found in %s!", SCENE_DIRECTORY );
 
-    for( int i = 0; i < TEX_COUNT; ++i ) {
-        auto* texture = state->game.textures + i;
-
-        *texture = LoadTexture( TEXTURE_LOAD_PARAMS[i].path );
-        SetTextureFilter( *texture, TEXTURE_LOAD_PARAMS[i].filter );
+    // NOTE(alicia): music and on demand textures are acquired by _game_prefetch.
+    if( !state->common.is_headless ) {
+        atlas_load( &s->atlas );
     }
-
-    for( int i = 0; i < MUS_COUNT; ++i ) {
-        auto* music = state->game.music + i;
-        *music = LoadMusicStream( __MUSIC_PATHS[i] );
+    for( auto*& music : s->music ) {
+        music = nullptr;
     }
 
-    s->scene.current_node = START_NODE;
+    s->scene->current = s->scene->index_of( START_NODE );
+
+    s->key.bg              = s->kv.id( "bg" );
+    s->key.music           = s->kv.id( "music" );
+    s->key.act             = s->kv.id( "act" );
+    s->key.one_playthrough = s->kv.id( "one-playthrough" );
+    s->key.start_game      = s->kv.id( "start-game" );
+    s->key.game_finished   = s->kv.id( "game-finished" );
+
+    _game_bind_scene_keys( s );
 
     s->current_music = -1;
-    s->kv.write( "music", 1 );
-    s->kv.write( "start-game", 1 );
+    s->kv.write( s->key.music, 1 );
+    s->kv.write( s->key.start_game, 1 );
+}
+void _game_bind_scene_keys( GameState* s ) {
+    s->scene_keys.reset();
+    s->scene_keys.reserve( s->scene->keys.len );
+
+    for( int i = 0; i < s->scene->keys.len; ++i ) {
+        s->scene_keys.push( s->kv.id( s->scene->get_key( i ) ) );
+    }
 }
 void _game_unload( State* state ) {
     auto* s = &state->game;
-    for( int i = 0; i < TEX_COUNT; ++i ) {
-        UnloadTexture( s->textures[i] );
-    }
-    for( int i = 0; i < MUS_COUNT; ++i ) {
-        if( i == s->current_music ) {
-            StopMusicStream( s->music[i] );
+    if( !state->common.is_headless ) {
+        atlas_unload( &s->atlas );
+        for( int i = 0; i < MUS_COUNT; ++i ) {
+            if( !s->music[i] ) {
+                continue;
+            }
+            if( i == s->current_music ) {
+                StopMusicStream( *s->music[i] );
+            }
+            asset_music_release( s->music[i] );
+            s->music[i] = nullptr;
         }
-        UnloadMusicStream( s->music[i] );
     }
-    s->scene.free();
+    if( s->scene ) {
+        scenes_release( s->scene );
+        s->scene = nullptr;
+    }
+    s->scene_keys.free();
     s->kv.free();
     s->buttons.free();
 }
@@ -703,7 +990,7 @@ void ButtonList::push( String text ) {
     buttons.push( button );
 }
 int ButtonList::update_and_draw(
-    Font font, Texture* textures, Vector2 screen, Vector2 mouse, bool left_pressed, float dt
+    Font font, const TextureAtlas* atlas, Vector2 screen, Vector2 mouse, bool left_pressed, float dt
 ) {
     int result = -1;
 
@@ -711,16 +998,21 @@ int ButtonList::update_and_draw(
     float max_width = -1.0f / 0.0f;
     float height    = font.baseSize * (29.0f / 16.0f);
 
+    // NOTE(alicia): text sizes are needed for width of all buttons
+    // and again when centering text so they are only measured once.
+    Vector2* text_sizes = mem_alloc<Vector2>( buttons.len, mem_frame() );
+
     for( int i = 0; i < buttons.len; ++i ) {
         auto& button = buttons[i];
 
         if( button.text.len ) {
             String text = button.text.to_string( string );
 
-            Vector2 size = MeasureTextEx( font, text.buf, font.baseSize, 1.0f );
+            font = font_cache_require( font, text );
+            text_sizes[i] = MeasureTextEx( font, text.buf, font.baseSize, 1.0f );
 
-            if( size.x > max_width ) {
-                max_width = size.x;
+            if( text_sizes[i].x > max_width ) {
+                max_width = text_sizes[i].x;
             }
         }
     }
@@ -752,14 +1044,14 @@ int ButtonList::update_and_draw(
         }
 
         auto frame = button.animation.update( dt );
-        auto tex   = textures[frame.texture];
+        auto tex   = atlas->texture( frame.texture );
 
         if( is_hovering && left_pressed ) {
             result = i;
         }
 
         Rectangle src = {}, dst = {};
-        src = frame.src;
+        src = atlas->src( frame.texture, frame.src );
 
         dst = button_rect;
 
@@ -773,14 +1065,13 @@ int ButtonList::update_and_draw(
 
         DrawTexturePro( tex, src, dst, {}, 0.0f, WHITE );
 
-        src = anim_middle->frames[button.animation.frame].src;
+        src = atlas->sprite( anim_middle->frames[button.animation.frame] ).src;
         dst = button_rect;
 
         DrawTexturePro( tex, src, dst, {}, 0.0f, WHITE );
 
-        String text = button.text.to_string( string );
-
-        Vector2 text_size = MeasureTextEx( font, text.buf, font.baseSize, 1.0f );
+        String  text      = button.text.to_string( string );
+        Vector2 text_size = text_sizes[i];
 
         Vector2 text_position = {};
         text_position.x = (button_rect.x + (button_rect.width / 2.0f)) - (text_size.x / 2.0f);
@@ -5,13 +5,14 @@
  * @date   August 08, 2025
 */
 #include "bog/state.h"
+#include "bog/replay.h"
 
 void _menu_update( State* state ) {
     auto* s = &state->menu;
 
-    float dt = GetFrameTime();
+    float dt = input_frame_time();
 
-    Vector2 mouse  = GetMousePosition();
+    Vector2 mouse  = input_mouse_position();
     Vector2 screen = { (float)GetScreenWidth(), (float)GetScreenHeight() };
 
     BeginDrawing();
@@ -25,17 +26,17 @@ void _menu_update( State* state ) {
 
     if( state->common.game_finished_once ) {
         DrawTexturePro(
-            s->second,
-            { 0, 0, (float)s->second.width, (float)s->second.height },
+            *s->second,
+            { 0, 0, (float)s->second->width, (float)s->second->height },
             { 0, 0, screen.x, screen.y }, {}, 0.0f, WHITE );
     } else {
         DrawTexturePro(
-            s->first,
-            { 0, 0, (float)s->first.width, (float)s->first.height },
+            *s->first,
+            { 0, 0, (float)s->first->width, (float)s->first->height },
             { 0, 0, screen.x, screen.y }, {}, 0.0f, WHITE );
     }
 
-    Texture tex = s->texture;
+    Texture tex = *s->texture;
 
     Rectangle src, dst;
     src = dst = {};
@@ -48,7 +49,7 @@ void _menu_update( State* state ) {
 
     DrawTexturePro( tex, src, dst, {}, 0.0f, WHITE );
 
-    bool left_pressed = IsMouseButtonPressed( MOUSE_BUTTON_LEFT );
+    bool left_pressed = input_mouse_pressed( MOUSE_BUTTON_LEFT );
 
     dst.y += dst.height + 40.0f;
     for( int i = 0; i < MAX_BUTTONS; ++i ) {
@@ -105,12 +106,9 @@ void _menu_update( State* state ) {
 void _menu_load( State* state ) {
     auto* s = &state->menu;
 
-    s->texture = LoadTexture( "resources/textures/menu_spritesheet.png" );
-    SetTextureFilter( s->texture, TEXTURE_FILTER_POINT );
-    s->first  = LoadTexture( "resources/textures/menu_background.png" );
-    SetTextureFilter( s->first, TEXTURE_FILTER_POINT );
-    s->second = LoadTexture( "resources/textures/menu_background2.png" );
-    SetTextureFilter( s->second, TEXTURE_FILTER_POINT );
+    s->texture = asset_texture_acquire( TEXTURE_LOAD_PARAMS[TEX_MENU].path );
+    s->first   = asset_texture_acquire( "resources/textures/menu_background.png" );
+    s->second  = asset_texture_acquire( "resources/textures/menu_background2.png" );
 
     for( size_t i = 0; i < ARRAY_LEN(s->buttons); ++i ) {
         auto* btn = s->buttons + i;
@@ -122,7 +120,7 @@ void _menu_load( State* state ) {
 void _menu_unload( State* state ) {
     auto* s = &state->menu;
 
-    UnloadTexture( s->texture );
-    UnloadTexture( s->first );
-    UnloadTexture( s->second );
+    asset_texture_release( s->texture );
+    asset_texture_release( s->first );
+    asset_texture_release( s->second );
 }
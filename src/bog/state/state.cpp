@@ -6,13 +6,17 @@
 */
 #include "bog/state.h"
 #include "bog/ui.h"
+#include "bog/fonts.h"
+#include "bog/profile.h"
 
 void state_set( State* state, StateType old_type ) {
     switch( old_type ) {
         case StateType::INVALID  : {
-            state->common.font = LoadFontEx(
-                "resources/fonts/martian-mono/MartianMono-Regular.ttf",
-                FONT_SIZE, 0, 0 );
+            if( state->common.is_headless ) {
+                break;
+            }
+            font_cache_load( "resources/fonts/martian-mono/MartianMono-Regular.ttf" );
+            state->common.font = font_cache_get( FONT_SIZE );
             state->common.settings.sfx    =
             state->common.settings.music  = 0.5f;
 
@@ -47,11 +51,19 @@ void state_set( State* state, StateType old_type ) {
 }
 
 void state_update( State* state ) {
+    PROFILE_ZONE( "state_update" );
+
     switch( state->type ) {
         case StateType::INVALID  : break;
         case StateType::INTRO    : _intro_update( state ); break;
         case StateType::MAIN_MENU: _menu_update( state ); break;
-        case StateType::GAME     : _game_update( state ); break;
+        case StateType::GAME     : {
+            if( state->common.is_headless ) {
+                _game_update_headless( state );
+            } else {
+                _game_update( state );
+            }
+        } break;
     }
 
     state->common.is_first_frame = false;
@@ -6,20 +6,62 @@
 */
 #include "bog/ui.h"
 #include "bog/state.h"
+#include "bog/profile.h"
+#include "bog/fonts.h"
+#include "bog/replay.h"
+#include "rlgl.h"
+
+// NOTE(alicia): GetGlyphIndex is a linear search over every glyph in font,
+// fonts with thousands of glyphs make that most of measuring text.
+struct UI_GlyphTable {
+    static constexpr int DIRECT_COUNT = 256;
+
+    u32        font_texture;
+    int        font_glyph_count;
+    GlyphInfo* font_glyphs;
+    Rectangle* font_recs;
+    u64        last_used;
+
+    /* ASCII and Latin-1, codepoint -> glyph index and advance */
+    int   index[DIRECT_COUNT];
+    float advance[DIRECT_COUNT];
+    /* every advance in font is a whole number so sums of advances are exact in any order */
+    bool  advance_is_integral;
+
+    /* wider codepoints, open addressing, glyph index + 1 or 0 if empty. len is always power of two */
+    List<int> slots;
+    /* glyph of '?', used for codepoints font does not have */
+    int       fallback;
+
+    int find( int codepoint ) const;
+
+    float advance_of( int index ) const {
+        if( font_glyphs[index].advanceX > 0 ) {
+            return font_glyphs[index].advanceX;
+        }
+        return font_recs[index].width + font_glyphs[index].offsetX;
+    }
+};
 
 struct StateUI {
-    static constexpr float TEXT_BASE_TIME = 0.005f;
+    static constexpr float TEXT_BASE_TIME         = 0.005f;
+    static constexpr int   LAYOUT_CACHE_SIZE      = 8;
+    static constexpr int   GLYPH_TABLE_CACHE_SIZE = 4;
 
     float text_display_speed = 1.0f;
 
-    List<UI_Word> words;
+    u64       layout_clock;
+    UI_Layout layouts[LAYOUT_CACHE_SIZE];
+
+    u64           glyph_table_clock;
+    UI_GlyphTable glyph_tables[GLYPH_TABLE_CACHE_SIZE];
 } __UI = {};
 
 Rectangle draw_settings( Settings* settings, Font font, bool* is_open ) {
     Rectangle rect = {};
 
     Vector2 screen = { (float)GetScreenWidth(), (float)GetScreenHeight() };
-    Vector2 mouse  = GetMousePosition();
+    Vector2 mouse  = input_mouse_position();
 
     rect.width  = 480.0f;
     rect.height = 300.0f;
@@ -63,7 +105,7 @@ Rectangle draw_settings( Settings* settings, Font font, bool* is_open ) {
     if( CheckCollisionPointRec( mouse, control_area ) ) {
         float delta = (mouse.x - control_area.x) / control_area.width;
 
-        if( IsMouseButtonDown( MOUSE_BUTTON_LEFT ) ) {
+        if( input_mouse_down( MOUSE_BUTTON_LEFT ) ) {
             settings->volume = delta;
         }
     }
@@ -79,7 +121,7 @@ Rectangle draw_settings( Settings* settings, Font font, bool* is_open ) {
     if( CheckCollisionPointRec( mouse, control_area ) ) {
         float delta = (mouse.x - control_area.x) / control_area.width;
 
-        if( IsMouseButtonDown( MOUSE_BUTTON_LEFT ) ) {
+        if( input_mouse_down( MOUSE_BUTTON_LEFT ) ) {
             settings->sfx = delta;
         }
     }
@@ -95,7 +137,7 @@ Rectangle draw_settings( Settings* settings, Font font, bool* is_open ) {
     if( CheckCollisionPointRec( mouse, control_area ) ) {
         float delta = (mouse.x - control_area.x) / control_area.width;
 
-        if( IsMouseButtonDown( MOUSE_BUTTON_LEFT ) ) {
+        if( input_mouse_down( MOUSE_BUTTON_LEFT ) ) {
             settings->music = delta;
         }
     }
@@ -110,7 +152,7 @@ Rectangle draw_settings( Settings* settings, Font font, bool* is_open ) {
     if( CheckCollisionPointRec( mouse, { pos.x, pos.y, return_size.x, return_size.y } ) ) {
         DrawTextPro( font, return_text, pos, {}, 0.0f, font.baseSize, 1.0f, WHITE );
 
-        if( IsMouseButtonPressed( MOUSE_BUTTON_LEFT ) ) {
+        if( input_mouse_pressed( MOUSE_BUTTON_LEFT ) ) {
             *is_open = false;
         }
     } else {
@@ -124,7 +166,7 @@ Rectangle draw_credits( Font font, bool* is_open ) {
     Rectangle rect = {};
 
     Vector2 screen = { (float)GetScreenWidth(), (float)GetScreenHeight() };
-    Vector2 mouse  = GetMousePosition();
+    Vector2 mouse  = input_mouse_position();
 
     rect.width  = 800.0f;
     rect.height = 360.0f;
@@ -169,7 +211,7 @@ Rectangle draw_credits( Font font, bool* is_open ) {
     if( CheckCollisionPointRec( mouse, { pos.x, pos.y, return_size.x, return_size.y } ) ) {
         DrawTextPro( font, return_text, pos, {}, 0.0f, font.baseSize, 1.0f, WHITE );
 
-        if( IsMouseButtonPressed( MOUSE_BUTTON_LEFT ) ) {
+        if( input_mouse_pressed( MOUSE_BUTTON_LEFT ) ) {
             *is_open = false;
         }
     } else {
@@ -180,7 +222,7 @@ Rectangle draw_credits( Font font, bool* is_open ) {
     return rect;
 }
 
-Rectangle text_box_draw( Texture tex, float y_offset, float height, Rectangle* out ) {
+Rectangle text_box_draw( const TextureAtlas* atlas, float y_offset, float height, Rectangle* out ) {
     Vector2 screen = { (float)GetScreenWidth(), (float)GetScreenHeight() };
 
     Rectangle src_trim_top, dst_trim_top;
@@ -206,8 +248,9 @@ Rectangle text_box_draw( Texture tex, float y_offset, float height, Rectangle* o
     background.height = dst_trim_bot.y - background.y;
 
     DrawRectangleRec( background, COLOR_TEXT_BOX_BACKGROUND );
-    DrawTexturePro( tex, src_trim_top, dst_trim_top, {}, 0.0f, WHITE );
-    DrawTexturePro( tex, src_trim_bot, dst_trim_bot, {}, 0.0f, WHITE );
+    Texture tex = atlas->texture( TEX_MENU );
+    DrawTexturePro( tex, atlas->src( TEX_MENU, src_trim_top ), dst_trim_top, {}, 0.0f, WHITE );
+    DrawTexturePro( tex, atlas->src( TEX_MENU, src_trim_bot ), dst_trim_bot, {}, 0.0f, WHITE );
 
     Rectangle text_area = { 0.0f, y_offset, screen.x, height };
 
@@ -234,39 +277,182 @@ float text_display_time() {
     return __UI.text_display_speed * __UI.TEXT_BASE_TIME;
 }
 
-// NOTE(alicia): largely from raylib/MeasureTextEx
-Vector2 text_measure_slice( Font font, String string, float font_size, float spacing ) {
-    char*   text      = string.buf;
-    Vector2 text_size = {};
+static u32 text_codepoint_hash( int codepoint ) {
+    u32 hash = (u32)codepoint * 2654435769u;
+    return hash ^ (hash >> 16);
+}
 
-    int size              = string.len;
-    int temp_byte_counter = 0;
-    int byte_counter      = 0;
+int UI_GlyphTable::find( int codepoint ) const {
+    if( codepoint >= 0 && codepoint < DIRECT_COUNT ) {
+        return index[codepoint];
+    }
+    if( !slots.len ) {
+        return fallback;
+    }
 
-    float text_width      = 0.0f;
-    float temp_text_width = 0.0f;
+    u32 mask = slots.len - 1;
+    for( u32 i = text_codepoint_hash( codepoint ) & mask;; i = (i + 1) & mask ) {
+        int slot = slots[i];
+        if( !slot ) {
+            return fallback;
+        }
+        if( font_glyphs[slot - 1].value == codepoint ) {
+            return slot - 1;
+        }
+    }
+}
 
-    float text_height = font_size;
-    float scale_factor = font_size / (float)font.baseSize;
+// NOTE(alicia): same result as GetGlyphIndex for every codepoint,
+// first glyph with codepoint wins and missing codepoints get last '?' or glyph 0.
+static void text_glyph_table_build( UI_GlyphTable* table, Font font ) {
+    PROFILE_ZONE( "text_glyph_table_build" );
+
+    table->font_texture        = font.texture.id;
+    table->font_glyph_count    = font.glyphCount;
+    table->font_glyphs         = font.glyphs;
+    table->font_recs           = font.recs;
+    table->fallback            = 0;
+    table->advance_is_integral = true;
+
+    int wide_count = 0;
+    for( int i = 0; i < font.glyphCount; ++i ) {
+        int codepoint = font.glyphs[i].value;
+        if( codepoint == '?' ) {
+            table->fallback = i;
+        }
+        if( codepoint < 0 || codepoint >= UI_GlyphTable::DIRECT_COUNT ) {
+            wide_count++;
+        }
 
-    int letter = 0;
-    int index  = 0;
+        float advance = table->advance_of( i );
+        if( advance != (float)(int)advance ) {
+            table->advance_is_integral = false;
+        }
+    }
 
-    for( int i = 0; i < size; ) {
-        byte_counter++;
+    for( int i = 0; i < UI_GlyphTable::DIRECT_COUNT; ++i ) {
+        table->index[i] = -1;
+    }
 
-        int codepoint_byte_count = 0;
-        letter = GetCodepointNext( &text[i], &codepoint_byte_count );
-        index  = GetGlyphIndex( font, letter );
+    table->slots.reset();
+    if( wide_count ) {
+        int len = MINIMUM_ALLOC_COUNT;
+        while( len < (wide_count * 2) ) {
+            len *= 2;
+        }
+        table->slots.reserve( len );
+        table->slots.len = len;
+        memset( table->slots.buf, 0, sizeof(int) * len );
+    }
 
-        i += codepoint_byte_count;
+    u32 mask = table->slots.len - 1;
+    for( int i = 0; i < font.glyphCount; ++i ) {
+        int codepoint = font.glyphs[i].value;
+        if( codepoint >= 0 && codepoint < UI_GlyphTable::DIRECT_COUNT ) {
+            if( table->index[codepoint] < 0 ) {
+                table->index[codepoint] = i;
+            }
+            continue;
+        }
 
-        if( letter != '\n' ) {
-            if( font.glyphs[index].advanceX > 0 ) {
-                text_width += font.glyphs[index].advanceX;
-            } else {
-                text_width += (font.recs[index].width + font.glyphs[index].offsetX);
+        u32 at = text_codepoint_hash( codepoint ) & mask;
+        while( table->slots[at] ) {
+            if( font.glyphs[table->slots[at] - 1].value == codepoint ) {
+                break;
             }
+            at = (at + 1) & mask;
+        }
+        if( !table->slots[at] ) {
+            table->slots[at] = i + 1;
+        }
+    }
+
+    for( int i = 0; i < UI_GlyphTable::DIRECT_COUNT; ++i ) {
+        if( table->index[i] < 0 ) {
+            table->index[i] = table->fallback;
+        }
+        table->advance[i] = font.glyphCount ? table->advance_of( table->index[i] ) : 0.0f;
+    }
+}
+
+static const UI_GlyphTable* text_glyph_table( Font font ) {
+    __UI.glyph_table_clock++;
+
+    UI_GlyphTable* oldest = __UI.glyph_tables;
+    for( int i = 0; i < StateUI::GLYPH_TABLE_CACHE_SIZE; ++i ) {
+        UI_GlyphTable* table = __UI.glyph_tables + i;
+        if(
+            table->font_glyphs      == font.glyphs     &&
+            table->font_recs        == font.recs       &&
+            table->font_texture     == font.texture.id &&
+            table->font_glyph_count == font.glyphCount
+        ) {
+            table->last_used = __UI.glyph_table_clock;
+            return table;
+        }
+
+        if( table->last_used < oldest->last_used ) {
+            oldest = table;
+        }
+    }
+
+    oldest->last_used = __UI.glyph_table_clock;
+    text_glyph_table_build( oldest, font );
+
+    return oldest;
+}
+
+// NOTE(alicia): sum of advances of a run of single byte codepoints.
+// four independent sums so adds do not wait on each other, only when
+// advances are whole numbers so that result is the same as adding in order.
+static float text_advance_sum( const UI_GlyphTable* table, const char* bytes, int len, float sum ) {
+    const float* advance = table->advance;
+
+    int i = 0;
+    if( table->advance_is_integral ) {
+        float sums[4] = { sum, 0.0f, 0.0f, 0.0f };
+        for( ; (i + 4) <= len; i += 4 ) {
+            sums[0] += advance[(u8)bytes[i + 0]];
+            sums[1] += advance[(u8)bytes[i + 1]];
+            sums[2] += advance[(u8)bytes[i + 2]];
+            sums[3] += advance[(u8)bytes[i + 3]];
+        }
+        sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+    for( ; i < len; ++i ) {
+        sum += advance[(u8)bytes[i]];
+    }
+
+    return sum;
+}
+
+// NOTE(alicia): largely from raylib/MeasureTextEx
+// split up so that layout can measure every prefix of a word in one pass.
+struct TextMeasureState {
+    const UI_GlyphTable* table;
+
+    float font_size;
+    float spacing;
+    float scale_factor;
+
+    int temp_byte_counter;
+    int byte_counter;
+
+    float text_width;
+    float temp_text_width;
+    float text_height;
+
+    TextMeasureState( Font font, float font_size, float spacing ) :
+        table(text_glyph_table( font )), font_size(font_size), spacing(spacing),
+        scale_factor(font_size / (float)font.baseSize),
+        temp_byte_counter(0), byte_counter(0),
+        text_width(0.0f), temp_text_width(0.0f), text_height(font_size) {}
+
+    void push( int letter ) {
+        byte_counter++;
+
+        if( letter != '\n' ) {
+            text_width += table->advance_of( table->find( letter ) );
         } else {
             if( temp_text_width < text_width ) {
                 temp_text_width = text_width;
@@ -282,16 +468,60 @@ Vector2 text_measure_slice( Font font, String string, float font_size, float spa
         }
     }
 
-    if( temp_text_width < text_width ) {
-        temp_text_width = text_width;
+    /* run of single byte codepoints without new-lines */
+    void push_run( const char* bytes, int len ) {
+        byte_counter += len;
+        text_width    = text_advance_sum( table, bytes, len, text_width );
+
+        if( temp_byte_counter < byte_counter ) {
+            temp_byte_counter = byte_counter;
+        }
     }
 
-    text_size.x = temp_text_width*scale_factor + (float)( (temp_byte_counter - 1) * spacing );
-    text_size.y = text_height;
+    Vector2 size() const {
+        float width = temp_text_width;
+        if( width < text_width ) {
+            width = text_width;
+        }
+
+        Vector2 text_size = {};
+        text_size.x = width*scale_factor + (float)( (temp_byte_counter - 1) * spacing );
+        text_size.y = text_height;
+        return text_size;
+    }
+};
+
+Vector2 text_measure_slice( Font font, String string, float font_size, float spacing ) {
+    TextMeasureState measure = { font, font_size, spacing };
+
+    for( int i = 0; i < string.len; ) {
+        int run = 0;
+        while(
+            (i + run) < string.len &&
+            (u8)string.buf[i + run] < 0x80 &&
+            string.buf[i + run] != '\n'
+        ) {
+            run++;
+        }
+        if( run ) {
+            measure.push_run( string.buf + i, run );
+            i += run;
+            continue;
+        }
+
+        int codepoint_byte_count = 0;
+        int letter = GetCodepointNext( &string.buf[i], &codepoint_byte_count );
+
+        i += codepoint_byte_count;
+
+        measure.push( letter );
+    }
 
-    return text_size;
+    return measure.size();
 }
 int text_split_words( Font font, String text, float font_size, List<UI_Word>* out_words ) {
+    PROFILE_ZONE( "text_split_words" );
+
     int word_count = 0;
     String str = text;
 
@@ -361,73 +591,56 @@ int text_split_words( Font font, String text, float font_size, List<UI_Word>* ou
     return word_count;
 }
 
-struct TextCommandState {
-    Color tint = WHITE;
-};
+// NOTE(alicia): same quad as raylib/DrawTextCodepoint
+static void text_glyph_quad( Font font, int index, Vector2 position, float font_size, UI_Glyph* out ) {
+    float scale_factor = font_size / font.baseSize;
+    float padding      = font.glyphPadding;
 
-Vector2 __word_draw(
-    Font              font,
-    UI_Word           word,
-    Vector2           position,
-    float             font_size,
-    TextCommandState* state
-) {
-    switch( word.type ) {
-        case UI_WordType::TEXT: {
-            Vector2 pos = position;
+    Rectangle rec = font.recs[index];
 
-            String str = word.text.value;
-            for( int i = 0; i < str.len; ++i ) {
-                auto info = GetGlyphInfo( font, str[i] );
-                DrawTextCodepoint( font, str[i], pos, font_size, state->tint );
+    out->dst.x      = position.x + (font.glyphs[index].offsetX - padding) * scale_factor;
+    out->dst.y      = position.y + (font.glyphs[index].offsetY - padding) * scale_factor;
+    out->dst.width  = (rec.width  + 2.0f * padding) * scale_factor;
+    out->dst.height = (rec.height + 2.0f * padding) * scale_factor;
 
-                pos.x += info.advanceX;
-            }
-
-            return pos;
-        } break;
-        case UI_WordType::COMMAND_COLOR: {
-            state->tint = word.command_color.color;
-        } break;
-    }
+    float width  = font.texture.width  ? (float)font.texture.width  : 1.0f;
+    float height = font.texture.height ? (float)font.texture.height : 1.0f;
 
-    return position;
+    out->uv.x      = (rec.x - padding) / width;
+    out->uv.y      = (rec.y - padding) / height;
+    out->uv.width  = (rec.width  + 2.0f * padding) / width;
+    out->uv.height = (rec.height + 2.0f * padding) / height;
 }
 
-Rectangle text_measure( Font font, String string, Vector2 position ) {
+static void text_layout_build( UI_Layout* layout, Font font, String string ) {
     float font_size = font.baseSize;
 
-    Rectangle bounds = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    Rectangle bounds = layout->bounds;
 
-    float start_x = position.x;
+    float start_x = layout->position.x;
     if( start_x < bounds.x ) {
         start_x = bounds.x;
     }
-    float start_y = position.y;
+    float start_y = layout->position.y;
     if( start_y < bounds.y ) {
         start_y = bounds.y;
     }
 
-    Rectangle rect = {};
-    *(Vector2*)&rect.x = { start_x, start_y };
+    layout->start = { start_x, start_y };
+    layout->glyphs.reset();
 
-    __UI.words.reset();
-    if( !text_split_words( font, string, font_size, &__UI.words ) ) {
-        return rect;
-    }
-
-    int max_chars = string.len;
+    List<UI_Word> words = {};
+    words.allocator = mem_frame();
+    layout->word_count = text_split_words( font, string, font_size, &words );
 
+    Color tint  = WHITE;
     float max_x = start_x, max_y = start_y;
 
     Rectangle word_rect = {};
     *(Vector2*)&word_rect.x = { start_x, start_y };
 
-    for( int i = 0; i < __UI.words.len; ++i ) {
-        if( !max_chars ) {
-            break;
-        }
-        auto* word = __UI.words + i;
+    for( int i = 0; i < words.len; ++i ) {
+        auto* word = words + i;
 
         switch( word->type ) {
             case UI_WordType::TEXT: {
@@ -438,11 +651,49 @@ Rectangle text_measure( Font font, String string, Vector2 position ) {
                     word_rect.y += word_rect.height;
                 }
 
-                if( word->text.value.len > max_chars ) {
-                    word->text.value.len = max_chars;
-
-                    word->text.size = text_measure_slice( font, word->text.value, font_size );
-                    *(Vector2*)&word_rect.width = word->text.size;
+                String  str = word->text.value;
+                Vector2 pos = *(Vector2*)&word_rect.x;
+
+                layout->glyphs.reserve( str.len );
+
+                // NOTE(alicia): extent of each glyph is the size of text if it
+                // were cut off after that glyph, same as measuring the word prefix.
+                TextMeasureState measure = { font, font_size, 1.0f };
+                Vector2 extent = { max_x, max_y };
+
+                for( int j = 0; j < str.len; ) {
+                    int codepoint_byte_count = 0;
+                    int letter = GetCodepointNext( &str.buf[j], &codepoint_byte_count );
+                    if( codepoint_byte_count < 1 ) {
+                        codepoint_byte_count = 1;
+                    }
+                    measure.push( letter );
+
+                    Vector2 size = measure.size();
+                    Vector2 end  = { word_rect.x + size.x, word_rect.y + size.y };
+
+                    int index = measure.table->find( letter );
+
+                    // NOTE(alicia): quad goes on first byte of codepoint,
+                    // rest of its bytes get empty glyphs so glyphs still line up with bytes.
+                    for( int k = 0; k < codepoint_byte_count && j < str.len; ++k, ++j ) {
+                        if( (k + 1) == codepoint_byte_count ) {
+                            extent.x = end.x > max_x ? end.x : max_x;
+                            extent.y = end.y > max_y ? end.y : max_y;
+                        }
+
+                        UI_Glyph glyph = {};
+                        glyph.tint   = tint;
+                        glyph.c      = str[j];
+                        glyph.extent = extent;
+                        if( !k ) {
+                            text_glyph_quad( font, index, pos, font_size, &glyph );
+                        }
+
+                        layout->glyphs.push( glyph );
+                    }
+
+                    pos.x += font.glyphs[index].advanceX;
                 }
 
                 float end_x, end_y;
@@ -455,21 +706,163 @@ Rectangle text_measure( Font font, String string, Vector2 position ) {
                     max_y = end_y;
                 }
 
-                max_chars -= word->text.value.len;
-
                 word_rect.x += word_rect.width;
             } break;
-            default:
-                break;
+            case UI_WordType::COMMAND_COLOR: {
+                tint = word->command_color.color;
+            } break;
+        }
+    }
+
+    // NOTE(alicia): gives words back to frame arena if nothing was allocated after.
+    words.free();
+}
+
+static bool text_layout_matches(
+    const UI_Layout* layout, Font font, String string, Vector2 position, Rectangle bounds
+) {
+    return
+        layout->buf          == string.buf         &&
+        layout->len          == string.len         &&
+        layout->font_texture == font.texture.id    &&
+        layout->font_size    == font.baseSize      &&
+        memcmp( &layout->bounds, &bounds, sizeof(bounds) ) == 0 &&
+        memcmp( &layout->position, &position, sizeof(position) ) == 0;
+}
+
+const UI_Layout* text_layout( Font font, String string, Vector2 position, Rectangle bounds ) {
+    u32 hash = string_hash( string );
+
+    __UI.layout_clock++;
+
+    UI_Layout* oldest = __UI.layouts;
+    for( int i = 0; i < StateUI::LAYOUT_CACHE_SIZE; ++i ) {
+        UI_Layout* layout = __UI.layouts + i;
+        if(
+            layout->hash == hash &&
+            text_layout_matches( layout, font, string, position, bounds )
+        ) {
+            layout->last_used = __UI.layout_clock;
+            return layout;
         }
+
+        if( layout->last_used < oldest->last_used ) {
+            oldest = layout;
+        }
+    }
+
+    oldest->buf          = string.buf;
+    oldest->len          = string.len;
+    oldest->hash         = hash;
+    oldest->font_texture = font.texture.id;
+    oldest->font_size    = font.baseSize;
+    oldest->bounds       = bounds;
+    oldest->position     = position;
+    oldest->last_used    = __UI.layout_clock;
+    oldest->id           = __UI.layout_clock;
+
+    // NOTE(alicia): glyphs are only rasterized when layout is built,
+    // drawing a cached layout needs nothing new from font.
+    font = font_cache_require( font, string );
+
+    text_layout_build( oldest, font, string );
+
+    return oldest;
+}
+
+// NOTE(alicia): all glyphs go out as one batch of quads against font atlas,
+// color commands are just vertex colors.
+static void text_glyphs_draw( Font font, int count, const UI_Glyph* glyphs ) {
+    if( !count ) {
+        return;
+    }
+
+    rlCheckRenderBatchLimit( count * 4 );
+
+    rlSetTexture( font.texture.id );
+    rlBegin( RL_QUADS );
+    rlNormal3f( 0.0f, 0.0f, 1.0f );
+
+    for( int i = 0; i < count; ++i ) {
+        auto* glyph = glyphs + i;
+        if( glyph->c == ' ' || glyph->c == '\t' || !glyph->dst.width ) {
+            continue;
+        }
+
+        Rectangle dst = glyph->dst;
+        Rectangle uv  = glyph->uv;
+
+        rlColor4ub( glyph->tint.r, glyph->tint.g, glyph->tint.b, glyph->tint.a );
+
+        rlTexCoord2f( uv.x, uv.y );
+        rlVertex2f( dst.x, dst.y );
+
+        rlTexCoord2f( uv.x, uv.y + uv.height );
+        rlVertex2f( dst.x, dst.y + dst.height );
+
+        rlTexCoord2f( uv.x + uv.width, uv.y + uv.height );
+        rlVertex2f( dst.x + dst.width, dst.y + dst.height );
+
+        rlTexCoord2f( uv.x + uv.width, uv.y );
+        rlVertex2f( dst.x + dst.width, dst.y );
     }
 
-    rect.width  = max_x - start_x;
-    rect.height = max_y - start_y;
+    rlEnd();
+    rlSetTexture( 0 );
+}
+
+static Rectangle text_layout_rect( const UI_Layout* layout, int glyph_count ) {
+    Rectangle rect = {};
+    *(Vector2*)&rect.x = layout->start;
+
+    if( glyph_count ) {
+        Vector2 extent = layout->glyphs[glyph_count - 1].extent;
+
+        rect.width  = extent.x - layout->start.x;
+        rect.height = extent.y - layout->start.y;
+    }
 
     return rect;
 }
 
+Rectangle text_measure( Font font, String string, Vector2 position ) {
+    Rectangle bounds = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
+
+    const UI_Layout* layout = text_layout( font, string, position, bounds );
+
+    return text_layout_rect( layout, layout->glyphs.len );
+}
+
+void text_display_update( DisplayTextState* state, float dt ) {
+    state->timer += dt;
+    if( state->timer >= text_display_time() ) {
+        state->timer = 0.0f;
+        state->len++;
+    }
+}
+
+// NOTE(alicia): layout stays in cache while it is drawn every frame,
+// so the cursor only has to check that its slot was not rebuilt for
+// another string. skips hashing string, which is most of text_layout.
+static const UI_Layout* text_display_layout(
+    DisplayTextState* state, Font font, String string, Vector2 position, Rectangle bounds
+) {
+    auto* layout = (UI_Layout*)state->layout;
+    if(
+        layout                          &&
+        layout->id == state->layout_id &&
+        text_layout_matches( layout, font, string, position, bounds )
+    ) {
+        layout->last_used = ++__UI.layout_clock;
+        return layout;
+    }
+
+    state->layout    = text_layout( font, string, position, bounds );
+    state->layout_id = state->layout->id;
+
+    return state->layout;
+}
+
 Rectangle text_draw(
     Font              font,
     String            string,
@@ -478,29 +871,21 @@ Rectangle text_draw(
     DisplayTextState* state,
     float             dt
 ) {
-    TextCommandState cmd_state = {};
-    float font_size            = font.baseSize;
+    PROFILE_ZONE( "text_draw" );
 
     Rectangle bounds = { 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() };
     if( bounds_ptr ) {
         bounds = *bounds_ptr;
     }
 
-    float start_x = position.x;
-    if( start_x < bounds.x ) {
-        start_x = bounds.x;
+    const UI_Layout* layout = nullptr;
+    if( state ) {
+        layout = text_display_layout( state, font, string, position, bounds );
+    } else {
+        layout = text_layout( font, string, position, bounds );
     }
-    float start_y = position.y;
-    if( start_y < bounds.y ) {
-        start_y = bounds.y;
-    }
-
-    Rectangle rect = {};
-    *(Vector2*)&rect.x = { start_x, start_y };
-
-    __UI.words.reset();
-    if( !text_split_words( font, string, font_size, &__UI.words ) ) {
-        return rect;
+    if( !layout->word_count ) {
+        return text_layout_rect( layout, 0 );
     }
 
     int max_chars = string.len;
@@ -511,70 +896,22 @@ Rectangle text_draw(
             max_chars = state->len;
         }
 
-        state->timer += dt;
-        if( state->timer >= text_display_time() ) {
-            state->timer = 0.0f;
-            state->len++;
-        }
+        text_display_update( state, dt );
     }
 
-    BeginScissorMode( bounds.x, bounds.y, bounds.width, bounds.height );
-
-    float max_x = start_x, max_y = start_y;
-
-    Rectangle word_rect = {};
-    *(Vector2*)&word_rect.x = { start_x, start_y };
-
-    for( int i = 0; i < __UI.words.len; ++i ) {
-        if( !max_chars ) {
-            break;
-        }
-        auto* word = __UI.words + i;
-
-        switch( word->type ) {
-            case UI_WordType::TEXT: {
-                *(Vector2*)&word_rect.width = word->text.size;
-
-                if( (word_rect.x + word_rect.width) >= (bounds.x + bounds.width) ) {
-                    word_rect.x = start_x;
-                    word_rect.y += word_rect.height;
-                }
-
-                if( word->text.value.len > max_chars ) {
-                    word->text.value.len = max_chars;
-
-                    word->text.size = text_measure_slice( font, word->text.value, font_size );
-                    *(Vector2*)&word_rect.width = word->text.size;
-                }
-
-                float end_x, end_y;
-                end_x = (word_rect.x + word_rect.width);
-                end_y = (word_rect.y + word_rect.height);
-                if( end_x > max_x ) {
-                    max_x = end_x;
-                }
-                if( end_y > max_y ) {
-                    max_y = end_y;
-                }
-
-                __word_draw( font, *word, *(Vector2*)&word_rect.x, font_size, &cmd_state );
+    // NOTE(alicia): typewriter effect only moves how many glyphs are visible.
+    int glyph_count = layout->glyphs.len;
+    if( max_chars < glyph_count ) {
+        glyph_count = max_chars;
+    }
 
-                max_chars -= word->text.value.len;
+    BeginScissorMode( bounds.x, bounds.y, bounds.width, bounds.height );
 
-                word_rect.x += word_rect.width;
-            } break;
-            case UI_WordType::COMMAND_COLOR: {
-                __word_draw( font, *word, *(Vector2*)&word_rect.x, font_size, &cmd_state );
-            } break;
-        }
-    }
+    text_glyphs_draw( font, glyph_count, layout->glyphs.buf );
 
     EndScissorMode();
 
-    rect.width  = max_x - start_x;
-    rect.height = max_y - start_y;
-
-    return rect;
+    return text_layout_rect( layout, glyph_count );
 }
 
 Vector2 fit_to_dst( Vector2 dst, Vector2 size ) {
@@ -6,8 +6,14 @@
 */
 #include "bog/prelude.h" // IWYU pragma: keep
 #include "bog/entry.h"
+#include "bog/scene.h"
+#include "bog/bench.h"
+#include "bog/headless.h"
+#include "bog/atlas.h"
+#include "bog/replay.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
@@ -21,8 +27,31 @@ void* memory      = NULL;
 
 void Update(void);
 
+int compile_scenes( int count, char** paths );
+
 int main( int argc, char** argv ) {
-    (void)argc, (void)argv;
+    if( argc > 1 && strcmp( argv[1], "-compile-scene" ) == 0 ) {
+        return compile_scenes( argc - 2, argv + 2 );
+    }
+    if( argc > 1 && strcmp( argv[1], "-pack-atlas" ) == 0 ) {
+        return atlas_pack() ? 0 : 1;
+    }
+    if( argc > 1 && strcmp( argv[1], "-bench" ) == 0 ) {
+        return bench_run( argc - 2, argv + 2 );
+    }
+    if( argc > 1 && strcmp( argv[1], "-headless" ) == 0 ) {
+        return headless_run( argc - 2, argv + 2 );
+    }
+    if( argc > 2 && strcmp( argv[1], "-record" ) == 0 ) {
+        if( !replay_record( argv[2] ) ) {
+            return 1;
+        }
+    }
+    if( argc > 2 && strcmp( argv[1], "-replay" ) == 0 ) {
+        if( !replay_playback( argv[2] ) ) {
+            return 1;
+        }
+    }
 
 #if !defined(IS_DEBUG)
     SetTraceLogLevel( LOG_NONE );
@@ -42,7 +71,8 @@ int main( int argc, char** argv ) {
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop( Update, 0, 1 );
 #else
-    SetTargetFPS(60);
+    // NOTE(alicia): playback runs frames as fast as they render.
+    SetTargetFPS( replay_mode() == ReplayMode::PLAYBACK ? 0 : 60 );
 
     while( !WindowShouldClose() ) {
         Update();
@@ -52,8 +82,32 @@ int main( int argc, char** argv ) {
     }
 #endif
 
+    int result = replay_finish();
+
     on_close( memory );
     CloseWindow();
+    return result;
+}
+
+int compile_scenes( int count, char** paths ) {
+    if( !count ) {
+        fprintf( stderr, "ERROR: -compile-scene requires at least one scene path!\n" );
+        return 1;
+    }
+
+    for( int i = 0; i < count; ++i ) {
+        const char* dst = TextFormat(
+            "%s/%s" SCENE_COMPILED_EXT,
+            GetDirectoryPath( paths[i] ), GetFileNameWithoutExt( paths[i] ) );
+
+        if( !scene_compile( paths[i], dst ) ) {
+            fprintf( stderr, "ERROR: failed to compile scene %s!\n", paths[i] );
+            return 1;
+        }
+
+        printf( "%s -> %s\n", paths[i], dst );
+    }
+
     return 0;
 }
 
@@ -14,5 +14,14 @@
 #include "../src/bog/allocation.cpp"
 #include "../src/bog/collections.cpp"
 #include "../src/bog/ui.cpp"
+#include "../src/bog/fonts.cpp"
 #include "../src/bog/scene.cpp"
+#include "../src/bog/scenes.cpp"
+#include "../src/bog/atlas.cpp"
+#include "../src/bog/loader.cpp"
+#include "../src/bog/assets.cpp"
+#include "../src/bog/bench.cpp"
+#include "../src/bog/headless.cpp"
+#include "../src/bog/replay.cpp"
+#include "../src/bog/profile.cpp"
 